@@ -0,0 +1,227 @@
+/**
+ * @file    bench.c
+ * @brief   Scheduler benchmark
+ *
+ * Registers from 1 to BENCH_COUNT_MAX tasks and as many periodic timers with mixed periods
+ * and runs them on the wall clock and on the simulated clock, with and without ticks. Every
+ * run reports the CPU the scheduler thread used per wakeup of its loop. Wall clock runs also
+ * report the time it was busy out of its waits, the dispatch overhead of the ticks it ran and
+ * the release lateness percentiles, none of them mean anything on the virtual clock, where
+ * the scheduler never waits and every release is on time. Idle runs with nothing due show
+ * what waiting costs. The results go to stdout as JSON so runs of different builds and
+ * modes can be diffed
+ *
+ * Usage: bench [-w | -s] [-n tasks] [-d ms]
+ */
+
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "scheduler.h"
+#include "stats.h"
+
+
+#define BENCH_COUNT_MAX     100000u     /*!< biggest number of tasks and of timers */
+#define BENCH_SAMPLES       256u        /*!< tasks with statistics, spread over the task set */
+#define BENCH_TICK          SCHED_MS( 1 )   /*!< scheduler tick */
+#define BENCH_DURATION      1000u       /*!< default length of every run in ms */
+
+
+/**
+ * @brief   Periods in ticks the tasks and the timers take in turns
+*/
+static const uint32_t periods[] = { 1, 2, 5, 10, 20, 50, 100, 200 };
+
+static Sched_Task tasks[ BENCH_COUNT_MAX ];
+static Sched_Timer timers[ BENCH_COUNT_MAX ];
+static Sched_Scheduler Sche;
+static Stats_Record lateness;
+static uint64_t taskRuns;
+static uint64_t expirations;
+
+
+void benchInit(void);
+void benchTask(void);
+void benchTimer( uint32_t missed );
+
+
+/**
+ * @brief   Thread CPU function
+ *
+ * Reads the CPU time used by the calling thread
+ *
+ * @retval  The CPU time in ns
+ */
+static uint64_t Bench_cpu( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_THREAD_CPUTIME_ID, &now );
+
+    return ( (uint64_t)now.tv_sec * 1000000000ull ) + (uint64_t)now.tv_nsec;
+}
+
+
+/**
+ * @brief   Run function
+ *
+ * Sets up the scheduler with the given number of tasks and timers, runs it and prints the
+ * results as one JSON object
+ *
+ * @param   count[in] Number of tasks and of timers
+ * @param   simulated[in] 1 to run on the simulated clock, 0 on the wall clock
+ * @param   tickless[in] 1 to skip the ticks without work
+ * @param   idle[in] 1 to give every task and timer a period longer than the run
+ * @param   duration[in] Scheduler time to run in ms
+ * @param   first[in] 1 for the first object of the list
+ *
+ * @retval  None
+ */
+static void Bench_run( uint32_t count, uint8_t simulated, uint8_t tickless, uint8_t idle, uint32_t duration, uint8_t first )
+{
+    uint32_t every = ( count > BENCH_SAMPLES ) ? ( count / BENCH_SAMPLES ) : 1u;
+    uint64_t wallStart;
+    uint64_t cpuStart;
+    uint64_t wall;
+    uint64_t cpu;
+    uint64_t wakeups;
+
+    Sche.tickUs = BENCH_TICK;
+    Sche.tasks = count;
+    Sche.taskPtr = tasks;
+    Sche.timers = count;
+    Sche.timerPtr = timers;
+    Sche.timeoutUs = SCHED_MS( duration );
+    Sche.simulated = simulated;
+    Sche.tickless = tickless;
+
+    Sched_initScheduler( &Sche );
+    Stats_initRecord( &lateness );
+
+    for ( uint32_t i = 0; i < count; i++ )
+    {
+        Sched_Time period = BENCH_TICK * periods[ i % ( sizeof( periods ) / sizeof( periods[ 0 ] ) ) ];
+        uint32_t task;
+        uint32_t timer;
+
+        if ( idle )
+        {
+            period = Sche.timeoutUs + BENCH_TICK;         // Nothing comes due during the run
+        }
+
+        task = Sched_registerTaskUs( &Sche, benchInit, benchTask, period );
+        timer = Sched_registerTimerModeUs( &Sche, period, SCHED_TIMER_PERIODIC, benchTimer );
+        Sched_startTimer( &Sche, timer );
+
+        if ( ( i % every ) == 0 )
+        {
+            Sched_statsTask( &Sche, task, &lateness );  // A sample is enough for the percentiles
+        }
+    }
+
+    taskRuns = 0;
+    expirations = 0;
+
+    wallStart = Stats_now();
+    cpuStart = Bench_cpu();
+    Sched_startScheduler( &Sche );
+    cpu = Bench_cpu() - cpuStart;
+    wall = Stats_now() - wallStart;
+
+    wakeups = Sched_wakeupsScheduler( &Sche );
+
+    printf( "%s\n    { \"clock\": \"%s\", \"mode\": \"%s\", \"work\": \"%s\", \"tasks\": %u, \"timers\": %u,",
+            first ? "" : ",", simulated ? "simulated" : "wall", tickless ? "tickless" : "tick", idle ? "idle" : "mixed", count, count );
+    printf( " \"ticks\": %llu, \"wakeups\": %llu, \"task_runs\": %llu, \"timer_expirations\": %llu,",
+            (unsigned long long)Sche.ticksCount, (unsigned long long)wakeups, (unsigned long long)taskRuns, (unsigned long long)expirations );
+    printf( " \"wall_ns\": %llu, \"cpu_ns\": %llu, \"cpu_ppm\": %llu, \"cpu_ns_per_wakeup\": %llu",
+            (unsigned long long)wall, (unsigned long long)cpu, (unsigned long long)( ( wall != 0 ) ? ( ( cpu * 1000000ull ) / wall ) : 0u ),
+            (unsigned long long)( ( wakeups != 0 ) ? ( cpu / wakeups ) : 0u ) );
+
+    if ( simulated == 0 )
+    {
+        uint32_t load = Sched_loadScheduler( &Sche, STATS_SECONDS );
+        uint64_t busy = ( wall * load ) / 1000000u;    // The tick mode busy waits, only the work counts
+
+        printf( ", \"busy_ns\": %llu, \"load_ppm\": %u, \"dispatch_ns_per_tick\": %llu, \"tick_jitter_ns\": %llu,",
+                (unsigned long long)busy, load, (unsigned long long)( ( wakeups != 0 ) ? ( busy / wakeups ) : 0u ), (unsigned long long)Sched_jitterScheduler( &Sche ) );
+        printf( " \"lateness_ns\": { \"p50\": %llu, \"p90\": %llu, \"p99\": %llu, \"max\": %llu }",
+                (unsigned long long)Stats_getLatenessPercentile( &lateness, 50 ), (unsigned long long)Stats_getLatenessPercentile( &lateness, 90 ),
+                (unsigned long long)Stats_getLatenessPercentile( &lateness, 99 ), (unsigned long long)( ( lateness.runs != 0 ) ? lateness.maxLateness : 0u ) );
+    }
+
+    printf( " }" );
+    fflush( stdout );
+}
+
+
+int main( int argc, char *argv[] )
+{
+    uint32_t max = BENCH_COUNT_MAX;
+    uint32_t duration = BENCH_DURATION;
+    uint8_t clocks = 0x3u;                              // Bit 0 wall clock, bit 1 simulated clock
+    uint8_t first = 1;
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        if ( strcmp( argv[ i ], "-w" ) == 0 )
+        {
+            clocks = 0x1u;
+        }
+        else if ( strcmp( argv[ i ], "-s" ) == 0 )
+        {
+            clocks = 0x2u;
+        }
+        else if ( ( strcmp( argv[ i ], "-n" ) == 0 ) && ( i + 1 < argc ) )
+        {
+            max = (uint32_t)strtoul( argv[ ++i ], NULL, 10 );
+        }
+        else if ( ( strcmp( argv[ i ], "-d" ) == 0 ) && ( i + 1 < argc ) )
+        {
+            duration = (uint32_t)strtoul( argv[ ++i ], NULL, 10 );
+        }
+        else
+        {
+            fprintf( stderr, "usage: %s [-w | -s] [-n tasks] [-d ms]\n", argv[ 0 ] );
+            return 1;
+        }
+    }
+
+    if ( ( max == 0 ) || ( max > BENCH_COUNT_MAX ) || ( duration == 0 ) )
+    {
+        fprintf( stderr, "%s: tasks go from 1 to %u and the duration can not be 0\n", argv[ 0 ], BENCH_COUNT_MAX );
+        return 1;
+    }
+
+    printf( "{\n  \"tick_us\": %llu, \"duration_ms\": %u,\n  \"runs\": [", (unsigned long long)BENCH_TICK, duration );
+
+    for ( uint8_t simulated = 0; simulated < 2; simulated++ )
+    {
+        for ( uint8_t tickless = 0; ( tickless < 2 ) && ( clocks & ( 1u << simulated ) ); tickless++ )
+        {
+            for ( uint32_t count = 1; count <= max; count *= 10u )
+            {
+                Bench_run( count, simulated, tickless, 0, duration, first );
+                first = 0;
+            }
+
+            if ( simulated == 0 )
+            {
+                Bench_run( max, simulated, tickless, 1, duration, first );     // What waiting costs
+            }
+        }
+    }
+
+    printf( "\n  ]\n}\n" );
+    Sched_deinitScheduler( &Sche );
+
+    return 0;
+}
+
+
+void benchInit(void) {}
+void benchTask(void) { taskRuns++; }
+void benchTimer( uint32_t missed ) { expirations += missed; }
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdint.h>
+#include <string.h>
 #include "scheduler.h"
 #include "queue.h"
 #include "rtcc.h"
@@ -23,6 +24,7 @@ typedef struct _Message
 
 #define TASKS_N     2
 #define TIMERS_N    4
+#define COROS_N     1
 #define TICK_VAL    100
 #define TIME_MSG    0
 #define DATE_MSG    1
@@ -33,11 +35,12 @@ static Sched_Scheduler Sche;
 static Rtcc_Clock rtccClock;
 static Que_Queue rtccQueue;
 static Sched_Timer timers[ TIMERS_N ];
-static uint8_t SetDateTimeID;
-static uint8_t SetDateTimeID1;
-static uint8_t SetDateTimeID2;
-static uint8_t SetDateTimeID3;
-static uint8_t Rtcc_callbackID;
+static Sched_Coro coros[ COROS_N ];
+static uint32_t SetDateTimeID1;
+static uint32_t SetDateTimeID2;
+static uint32_t SetDateTimeID3;
+static uint32_t Rtcc_callbackID;
+static uint32_t Task_500msID;
 static uint32_t setTimes[] = {5000, 3000, 8000};
 static uint8_t setTimesIndx = 0;
 
@@ -46,11 +49,19 @@ void Init_500ms(void);
 void Init_1000ms(void);
 void Task_500ms(void);
 void Task_1000ms(void);
-void Rtcc_callback(void);
-void SetDateTime(void);
+void Rtcc_callback( uint32_t expirations );
+void SetDateTime( Sched_Coro *coro );
 
 
-int main( void )
+/*the 1000ms task never changes, build it at compile time and call it straight from the scheduler loop*/
+#define TABLE_NAME      fixedTasks
+#define TABLE_TICK      SCHED_MS( TICK_VAL )
+#define TABLE_TASKS( TASK ) \
+    TASK( Init_1000ms, Task_1000ms, SCHED_MS( 1000 ) )
+#include "table.h"
+
+
+int main( int argc, char *argv[] )
 {
     static Message Messages[6u];
 
@@ -67,22 +78,48 @@ int main( void )
     Sche.timeout = 25000;
     Sche.timers = TIMERS_N;
     Sche.timerPtr = timers;
+    Sche.coros = COROS_N;
+    Sche.coroPtr = coros;
+
+    /*run on a virtual clock with -s, the 25 seconds take no time, or as a real-time thread on CPU 0 with -r*/
+    for ( int i = 1; i < argc; i++ )
+    {
+        Sche.simulated |= ( strcmp( argv[ i ], "-s" ) == 0 );
+        Sche.realtime |= ( strcmp( argv[ i ], "-r" ) == 0 );
+    }
+
+    Sche.rtPriority = 50;
+    Sche.cpu = 0;
 
     Sched_initScheduler( &Sche );
     
-    /*register two task with thier corresponding init fucntions and their periodicyt, 100ms and 500ms*/
-    Sched_registerTask( &Sche, Init_500ms, Task_500ms, 500 );
-    Sched_registerTask( &Sche, Init_1000ms, Task_1000ms, 1000 );
+    /*register the 500ms task with its init function and add the static table with the 1000ms one*/
+    Task_500msID = Sched_registerTask( &Sche, Init_500ms, Task_500ms, 500 );
+    Sched_tableScheduler( &Sche, &fixedTasks );
+
+    /*run the 500ms task every time the queue is written instead of polling it*/
+    Sched_triggerTask( &Sche, Task_500msID, &rtccQueue );
     
-    SetDateTimeID = Sched_registerTimer( &Sche, setTimes[0], SetDateTime);
-    Rtcc_callbackID = Sched_registerTimer( &Sche, 1000, Rtcc_callback );
+    Rtcc_callbackID = Sched_registerTimerMode( &Sche, 1000, SCHED_TIMER_PERIODIC, Rtcc_callback );
 
-    /*run the scheduler for the mount of time stablished in Sche.timeout*/
-    Sched_startTimer( &Sche, SetDateTimeID );
     Sched_startTimer( &Sche, Rtcc_callbackID );
 
+    /*change the date and time from a coroutine that sleeps between the changes*/
+    Sched_spawnCoro( &Sche, SetDateTime, NULL );
+
+    /*run the scheduler for the mount of time stablished in Sche.timeout*/
+
     Sched_startScheduler( &Sche );
-    
+
+    if ( Sche.realtime )
+    {
+        printf( "Real-time: fifo %u, locked %u, pinned %u, worst tick jitter %llu us\n",
+                ( Sche.rtStatus & SCHED_RT_FIFO ) != 0, ( Sche.rtStatus & SCHED_RT_LOCKED ) != 0,
+                ( Sche.rtStatus & SCHED_RT_PINNED ) != 0, (unsigned long long)( Sched_jitterScheduler( &Sche ) / 1000u ) );
+    }
+
+    Sched_deinitScheduler( &Sche );
+
     return 0;
 }
 
@@ -115,7 +152,7 @@ void Init_1000ms(void)
 /**
  * @brief   500ms task
  * 
- * Read the queue and print the time and date if a new message arrives
+ * Triggered by the queue writes, read the queue and print the time and date of the new messages
 */
 void Task_500ms(void)
 {
@@ -167,45 +204,53 @@ void Task_1000ms(void)
 /**
  * @brief   Rtcc_calback
  * 
- * Used to call Rtcc periodic task every second
+ * Used to call Rtcc periodic task every second, once for every second elapsed since the
+ * last call
 */
-void Rtcc_callback(void)
+void Rtcc_callback( uint32_t expirations )
 {
-    Rtcc_periodicTask( &rtccClock );
-    Sched_reloadTimer( &Sche, Rtcc_callbackID, 1000 );
+    while ( expirations-- != 0 )
+    {
+        Rtcc_periodicTask( &rtccClock );
+    }
 }
 
 
 /**
  * @brief SetDateTime
  * 
- * Set a new value for date and time at differerent elapsed times
+ * Coroutine that sets a new value for date and time at differerent elapsed times
  * 
 */
-void SetDateTime(void)
+void SetDateTime( Sched_Coro *coro )
 {
-    if (setTimesIndx == 0)
-    {
-        Rtcc_setDate( &rtccClock, 10, 12, 2002, 5 );
-        Rtcc_setTime( &rtccClock, 8, 54, 2 );
+    SCHED_CORO_BEGIN( coro );
 
-    }
-    else if (setTimesIndx == 1)
+    while ( 1 )
     {
-        Rtcc_setDate( &rtccClock, 5, 9, 1998, 4 );
-        Rtcc_setTime( &rtccClock, 4, 39, 11 );
+        SCHED_CORO_SLEEP( coro, setTimes[ setTimesIndx ] );
 
-    }
-    else if (setTimesIndx == 2)
-    {
-        Rtcc_setDate( &rtccClock, 9, 1, 2024, 3 );
-        Rtcc_setTime( &rtccClock, 16, 5, 6 );
+        if (setTimesIndx == 0)
+        {
+            Rtcc_setDate( &rtccClock, 10, 12, 2002, 5 );
+            Rtcc_setTime( &rtccClock, 8, 54, 2 );
 
-    }
+        }
+        else if (setTimesIndx == 1)
+        {
+            Rtcc_setDate( &rtccClock, 5, 9, 1998, 4 );
+            Rtcc_setTime( &rtccClock, 4, 39, 11 );
 
-    setTimesIndx = ( setTimesIndx + 1 ) % ( sizeof( setTimes ) / sizeof( setTimes[0] ) );
+        }
+        else if (setTimesIndx == 2)
+        {
+            Rtcc_setDate( &rtccClock, 9, 1, 2024, 3 );
+            Rtcc_setTime( &rtccClock, 16, 5, 6 );
 
-    Sched_reloadTimer( &Sche, SetDateTimeID, setTimes[ setTimesIndx ] );
+        }
 
+        setTimesIndx = ( setTimesIndx + 1 ) % ( sizeof( setTimes ) / sizeof( setTimes[0] ) );
+    }
 
+    SCHED_CORO_END( coro );
 }
@@ -0,0 +1,394 @@
+/**
+ * @file    pool.c
+ * @brief   Worker pool's source code
+ *
+ * This is a fixed pool of worker threads. Every worker owns a deque of jobs, it takes its
+ * own jobs from the oldest end and, once it runs out of them, it steals the newest jobs of
+ * the other workers. Pinned jobs go to a second deque that is never stolen. A job is never
+ * queued twice, so it can not overlap with itself
+ */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "pool.h"
+
+
+/**
+  * @defgroup POOL MACROS brief pool helpers
+  @{ */
+#define POOL_MASK   ( POOL_DEQUE_SIZE - 1u )    /*!< deque position mask */
+/**
+  @} */
+
+
+/**
+ * @brief Worker running on the calling thread, POOL_ANY_WORKER outside the pool
+*/
+static _Thread_local uint8_t currentWorker = POOL_ANY_WORKER;
+
+
+/**
+ * @brief   Init deque function
+ *
+ * Initializes an empty deque
+ *
+ * @param   deque[in] Pointer to a Pool_Deque variable
+ *
+ * @retval  None
+ */
+static void Pool_initDeque( Pool_Deque *deque )
+{
+    pthread_mutex_init( &deque->lock, NULL );
+    deque->head = 0;
+    deque->tail = 0;
+}
+
+
+/**
+ * @brief   Push function
+ *
+ * Queues a job at the newest end of a deque
+ *
+ * @param   deque[in] Pointer to a Pool_Deque variable
+ * @param   job[in] Pointer to the job
+ *
+ * @retval  1 if the job was queued, 0 if the deque is full
+ */
+static uint8_t Pool_push( Pool_Deque *deque, Pool_Job *job )
+{
+    uint8_t exit = 0;
+
+    pthread_mutex_lock( &deque->lock );
+
+    if ( deque->tail - deque->head < POOL_DEQUE_SIZE )
+    {
+        deque->jobs[ deque->tail & POOL_MASK ] = job;
+        deque->tail++;
+        exit = 1;
+    }
+
+    pthread_mutex_unlock( &deque->lock );
+
+    return exit;
+}
+
+
+/**
+ * @brief   Take function
+ *
+ * Takes a job from a deque, the owner takes the oldest job and thieves the newest one
+ *
+ * @param   deque[in] Pointer to a Pool_Deque variable
+ * @param   steal[in] 1 to take the newest job, 0 to take the oldest one
+ *
+ * @retval  Pointer to the job, NULL if the deque is empty
+ */
+static Pool_Job *Pool_take( Pool_Deque *deque, uint8_t steal )
+{
+    Pool_Job *job = NULL;
+
+    pthread_mutex_lock( &deque->lock );
+
+    if ( deque->head != deque->tail )
+    {
+        if ( steal )
+        {
+            deque->tail--;
+            job = deque->jobs[ deque->tail & POOL_MASK ];
+        }
+        else
+        {
+            job = deque->jobs[ deque->head & POOL_MASK ];
+            deque->head++;
+        }
+    }
+
+    pthread_mutex_unlock( &deque->lock );
+
+    return job;
+}
+
+
+/**
+ * @brief   Worker thread function
+ *
+ * Waits for jobs and runs them. A job is first reserved from the pool counters, so once
+ * reserved it is guaranteed to be found on the own pinned deque or on one of the shared ones
+ *
+ * @param   arg[in] Pointer to the Pool_Worker of the thread
+ *
+ * @retval  NULL
+ */
+static void *Pool_workerThread( void *arg )
+{
+    Pool_Worker *self = arg;
+    Pool *pool = self->pool;
+
+    currentWorker = self->index;
+
+    while ( 1 )
+    {
+        Pool_Job *job = NULL;
+        uint8_t pinned;
+
+        pthread_mutex_lock( &pool->lock );
+
+        while ( ( pool->stop == 0 ) && ( pool->shared == 0 ) && ( pool->pinned[ self->index ] == 0 ) )
+        {
+            pthread_cond_wait( &pool->wake, &pool->lock );
+        }
+
+        if ( pool->stop )
+        {
+            pthread_mutex_unlock( &pool->lock );
+            break;
+        }
+
+        pinned = ( pool->pinned[ self->index ] != 0 );
+
+        if ( pinned )
+        {
+            pool->pinned[ self->index ]--;              // Reserve a pinned job
+        }
+        else
+        {
+            pool->shared--;                             // Reserve a shared job
+        }
+
+        pthread_mutex_unlock( &pool->lock );
+
+        if ( pinned )
+        {
+            job = Pool_take( &self->pinned, 0 );
+        }
+
+        for ( uint32_t i = 0; job == NULL; i = ( i + 1u ) % pool->workers )
+        {
+            Pool_Worker *victim = &pool->worker[ ( self->index + i ) % pool->workers ];
+
+            job = Pool_take( &victim->shared, ( victim != self ) );    // Own jobs first, then steal
+        }
+
+        if ( job->runPtr != NULL )
+        {
+            job->runPtr( job );
+        }
+        else
+        {
+            job->func();
+        }
+
+        atomic_store( &job->busy, 0 );
+
+        pthread_mutex_lock( &pool->lock );
+
+        if ( --pool->inflight == 0 )
+        {
+            pthread_cond_broadcast( &pool->idle );
+        }
+
+        pthread_mutex_unlock( &pool->lock );
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief   Init pool function
+ *
+ * Initializes the pool and starts the worker threads
+ *
+ * @param   pool[in] Pointer to a Pool variable
+ * @param   workers[in] Number of worker threads, from 1 to POOL_WORKERS_MAX
+ *
+ * @retval  1 if the pool is running, 0 otherwise
+ */
+uint8_t Pool_initPool( Pool *pool, uint8_t workers )
+{
+    uint8_t exit = 0;
+
+    if ( ( workers >= 1 ) && ( workers <= POOL_WORKERS_MAX ) )
+    {
+        pthread_mutex_init( &pool->lock, NULL );
+        pthread_cond_init( &pool->wake, NULL );
+        pthread_cond_init( &pool->idle, NULL );
+        pool->shared = 0;
+        pool->inflight = 0;
+        pool->next = 0;
+        pool->stop = 0;
+        pool->workers = 0;
+        exit = 1;
+
+        for ( uint8_t i = 0; i < workers; i++ )
+        {
+            Pool_Worker *worker = &pool->worker[ i ];
+
+            worker->pool = pool;
+            worker->index = i;
+            pool->pinned[ i ] = 0;
+            Pool_initDeque( &worker->shared );
+            Pool_initDeque( &worker->pinned );
+        }
+
+        for ( uint8_t i = 0; ( i < workers ) && exit; i++ )
+        {
+            if ( pthread_create( &pool->worker[ i ].thread, NULL, Pool_workerThread, &pool->worker[ i ] ) == 0 )
+            {
+                pool->workers++;
+            }
+            else
+            {
+                Pool_stopPool( pool );                  // Could not start every worker
+                exit = 0;
+            }
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Init job function
+ *
+ * Initializes a job that can run on any worker
+ *
+ * @param   job[in] Pointer to a Pool_Job variable
+ * @param   func[in] Function the job runs
+ *
+ * @retval  None
+ */
+void Pool_initJob( Pool_Job *job, void (*func)(void) )
+{
+    job->func = func;
+    job->runPtr = NULL;
+    job->worker = POOL_ANY_WORKER;
+    atomic_store( &job->busy, 0 );
+}
+
+
+/**
+ * @brief   Submit function
+ *
+ * Queues a job on its pinned worker or on the next worker of the pool. A job that is still
+ * queued or running from a previous submit is not queued again
+ *
+ * @param   pool[in] Pointer to a Pool variable
+ * @param   job[in] Pointer to the job
+ *
+ * @retval  1 if the job was queued, 0 if it is still busy or every deque is full
+ */
+uint8_t Pool_submit( Pool *pool, Pool_Job *job )
+{
+    uint8_t exit = 0;
+
+    if ( atomic_exchange( &job->busy, 1 ) == 0 )
+    {
+        pthread_mutex_lock( &pool->lock );
+
+        if ( job->worker < pool->workers )
+        {
+            if ( Pool_push( &pool->worker[ job->worker ].pinned, job ) )
+            {
+                pool->pinned[ job->worker ]++;
+                pthread_cond_broadcast( &pool->wake );      // Make sure the pinned worker wakes up
+                exit = 1;
+            }
+        }
+        else
+        {
+            for ( uint8_t i = 0; ( i < pool->workers ) && ( exit == 0 ); i++ )
+            {
+                Pool_Worker *worker = &pool->worker[ pool->next ];
+
+                pool->next = ( pool->next + 1u ) % pool->workers;       // Round robin
+
+                if ( Pool_push( &worker->shared, job ) )
+                {
+                    pool->shared++;
+                    pthread_cond_signal( &pool->wake );
+                    exit = 1;
+                }
+            }
+        }
+
+        if ( exit )
+        {
+            pool->inflight++;
+        }
+        else
+        {
+            atomic_store( &job->busy, 0 );
+        }
+
+        pthread_mutex_unlock( &pool->lock );
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Wait function
+ *
+ * Blocks until every submitted job has finished
+ *
+ * @param   pool[in] Pointer to a Pool variable
+ *
+ * @retval  None
+ */
+void Pool_wait( Pool *pool )
+{
+    pthread_mutex_lock( &pool->lock );
+
+    while ( pool->inflight != 0 )
+    {
+        pthread_cond_wait( &pool->idle, &pool->lock );
+    }
+
+    pthread_mutex_unlock( &pool->lock );
+}
+
+
+/**
+ * @brief   Stop pool function
+ *
+ * Waits for the submitted jobs and finishes the worker threads
+ *
+ * @param   pool[in] Pointer to a Pool variable
+ *
+ * @retval  None
+ */
+void Pool_stopPool( Pool *pool )
+{
+    Pool_wait( pool );
+
+    pthread_mutex_lock( &pool->lock );
+    pool->stop = 1;
+    pthread_cond_broadcast( &pool->wake );
+    pthread_mutex_unlock( &pool->lock );
+
+    for ( uint8_t i = 0; i < pool->workers; i++ )
+    {
+        pthread_join( pool->worker[ i ].thread, NULL );
+    }
+
+    pool->workers = 0;
+}
+
+
+/**
+ * @brief   Current worker function
+ *
+ * Tells which worker is running the calling thread
+ *
+ * @retval  The worker number, POOL_ANY_WORKER if called outside the pool
+ */
+uint8_t Pool_currentWorker( void )
+{
+    return currentWorker;
+}
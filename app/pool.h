@@ -0,0 +1,66 @@
+#include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+#ifndef POOL_H_
+#define POOL_H_
+
+
+#define POOL_WORKERS_MAX    16u         /*!< maximum number of worker threads */
+#define POOL_DEQUE_SIZE     256u        /*!< jobs every worker deque can hold, power of two */
+#define POOL_ANY_WORKER     0xFFu       /*!< the job can run on any worker */
+
+
+/* STRUCTURES */
+typedef struct _Pool_Job
+{
+    void (*func)(void);         /*!< function to run */
+    void (*runPtr)( struct _Pool_Job *job );   /*!< wrapper run instead of func, NULL to call func directly */
+    uint8_t worker;             /*!< worker the job is pinned to or POOL_ANY_WORKER */
+    atomic_uchar busy;          /*!< 1 while the job is queued or running */
+} Pool_Job;
+
+
+typedef struct _Pool_Deque
+{
+    pthread_mutex_t lock;               /*!< deque lock */
+    Pool_Job *jobs[ POOL_DEQUE_SIZE ];  /*!< ring of queued jobs */
+    uint32_t head;                      /*!< oldest job, taken by the owner */
+    uint32_t tail;                      /*!< next free position, newest jobs are stolen from here */
+} Pool_Deque;
+
+
+typedef struct _Pool_Worker
+{
+    struct _Pool *pool;         /*!< pool the worker belongs to */
+    pthread_t thread;           /*!< worker thread */
+    uint8_t index;              /*!< worker number */
+    Pool_Deque shared;          /*!< jobs other workers can steal */
+    Pool_Deque pinned;          /*!< jobs pinned to this worker */
+} Pool_Worker;
+
+
+typedef struct _Pool
+{
+    uint8_t workers;                            /*!< number of worker threads */
+    Pool_Worker worker[ POOL_WORKERS_MAX ];     /*!< workers */
+    pthread_mutex_t lock;                       /*!< protects the counters below */
+    pthread_cond_t wake;                        /*!< signaled when jobs are queued */
+    pthread_cond_t idle;                        /*!< signaled when the last job finishes */
+    uint32_t shared;                            /*!< queued jobs any worker can take */
+    uint32_t pinned[ POOL_WORKERS_MAX ];        /*!< queued jobs pinned to every worker */
+    uint32_t inflight;                          /*!< jobs queued or running */
+    uint8_t next;                               /*!< next worker to get an unpinned job */
+    uint8_t stop;                               /*!< 1 to finish the worker threads */
+} Pool;
+
+
+uint8_t Pool_initPool( Pool *pool, uint8_t workers );
+void Pool_initJob( Pool_Job *job, void (*func)(void) );
+uint8_t Pool_submit( Pool *pool, Pool_Job *job );
+void Pool_wait( Pool *pool );
+void Pool_stopPool( Pool *pool );
+uint8_t Pool_currentWorker( void );
+
+
+#endif
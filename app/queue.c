@@ -8,7 +8,9 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include "queue.h"
+#include "trace.h"
 
 
 /** 
@@ -36,13 +38,15 @@ void Queue_initQueue( Que_Queue *queue )
    queue->Tail = 0;
    queue->Empty = TRUE;
    queue->Full = FALSE;
+   queue->Notify = NULL;
+   queue->Listener = NULL;
 }
 
 
 /**
  * @brief Write data function
  * 
- * This function writes data into the queue
+ * This function writes data into the queue and then calls the queue listener if it has one
  * 
  * @param queue[in] Pointer to a Que_Queue struct type. This is the queue's control struct
  * @param data[in] Pointer to the variable that has the info to write into the queue
@@ -75,6 +79,15 @@ uint8_t Queue_writeData( Que_Queue *queue, void *data )
     }
 
 
+    TRACE_EVENT( TRACE_QUEUE_WRITE, (uint32_t)(uintptr_t)queue );
+
+
+    if ( queue->Notify != NULL )
+    {
+        queue->Notify( queue->Listener );               // Tell the listener there is new data
+    }
+
+
     return exit;
 }
 
@@ -114,6 +127,8 @@ uint8_t Queue_readData( Que_Queue *queue, void *data )
             queue->Empty = TRUE;                        // Queue is empty
         }
 
+        TRACE_EVENT( TRACE_QUEUE_READ, (uint32_t)(uintptr_t)queue );
+
     }
 
     return exit;
@@ -138,7 +153,7 @@ uint8_t Queue_isQueueEmpty( Que_Queue *queue )
 /**
  * @brief FlushQueue function
  * 
- * This function restarts the queue
+ * This function restarts the queue, the listener is kept
  * 
  * @param queue[in] Pointer to a Que_Queue struct type. This is the queue's control struct
  * 
@@ -146,7 +161,30 @@ uint8_t Queue_isQueueEmpty( Que_Queue *queue )
 */
 void Queue_flushQueue( Que_Queue *queue )
 {
+    void (*notify)( void *listener ) = queue->Notify;
+    void *listener = queue->Listener;
+
     Queue_initQueue(queue);
+    Queue_setListener( queue, notify, listener );
+}
+
+
+/**
+ * @brief Set listener function
+ * 
+ * This function sets the function called after every write, so a reader can wait for data
+ * instead of polling the queue. Queue_initQueue removes the listener
+ * 
+ * @param queue[in] Pointer to a Que_Queue struct type. This is the queue's control struct
+ * @param notify[in] Function to call after every write, NULL to remove the listener
+ * @param listener[in] Parameter given to notify
+ * 
+ * @retval None
+*/
+void Queue_setListener( Que_Queue *queue, void (*notify)( void *listener ), void *listener )
+{
+    queue->Notify = notify;
+    queue->Listener = listener;
 }
 
 
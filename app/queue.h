@@ -13,6 +13,8 @@ typedef struct
     uint8_t    Tail;     //variable to signal the next queue space to read
     uint8_t    Empty;    //flag to indicate if the queue is empty
     uint8_t    Full;     //flag to indicate if the queue is full
+    void       (*Notify)( void *Listener ); //function called after every write, NULL for none
+    void       *Listener; //parameter given to Notify
     //agregar más elementos si se requieren
 } Que_Queue;
 
@@ -22,6 +24,7 @@ uint8_t Queue_writeData( Que_Queue *queue, void *data );
 uint8_t Queue_readData( Que_Queue *queue, void *data );
 uint8_t Queue_isQueueEmpty( Que_Queue *queue );
 void Queue_flushQueue( Que_Queue *queue );
+void Queue_setListener( Que_Queue *queue, void (*notify)( void *listener ), void *listener );
 
 
 #endif
\ No newline at end of file
@@ -0,0 +1,285 @@
+/**
+ * @file    ready.c
+ * @brief   Ready queue's source code
+ *
+ * This is the queue of tasks ready to run. With the FIFO policy it is a plain linked list,
+ * with the EDF policy it is a pairing heap ordered by the absolute deadline of every node,
+ * so pushing is O(1) and taking the earliest deadline is O(log n) amortized. With the
+ * priority policy every level has its own FIFO list and a bitmap of the non empty levels,
+ * the highest priority is found with a count trailing zeros, so both operations are O(1)
+ */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ready.h"
+
+
+/**
+ * @brief   Before function
+ *
+ * Tells if a node has to be taken before another one, earlier keys go first and equal keys
+ * go in push order. Keys are compared with wrap around
+ *
+ * @param   a[in] Pointer to the first node
+ * @param   b[in] Pointer to the second node
+ *
+ * @retval  1 if a goes before b, 0 otherwise
+ */
+static uint8_t Ready_before( Ready_Node *a, Ready_Node *b )
+{
+    int32_t diff = (int32_t)( a->key - b->key );
+
+    return ( diff < 0 ) || ( ( diff == 0 ) && ( (int32_t)( a->order - b->order ) < 0 ) );
+}
+
+
+/**
+ * @brief   Meld function
+ *
+ * Joins two heaps, the root that goes later becomes the first child of the other one
+ *
+ * @param   a[in] Root of the first heap
+ * @param   b[in] Root of the second heap
+ *
+ * @retval  Root of the joined heap
+ */
+static Ready_Node *Ready_meld( Ready_Node *a, Ready_Node *b )
+{
+    Ready_Node *root = a;
+
+    if ( Ready_before( b, a ) )
+    {
+        root = b;
+        b = a;
+    }
+
+    b->next = root->child;
+    root->child = b;
+
+    return root;
+}
+
+
+/**
+ * @brief   Merge pairs function
+ *
+ * Joins the children of a removed root, first in pairs from left to right and then the
+ * pairs from right to left
+ *
+ * @param   first[in] First node of the children list
+ *
+ * @retval  Root of the resulting heap
+ */
+static Ready_Node *Ready_mergePairs( Ready_Node *first )
+{
+    Ready_Node *pairs = NULL;
+    Ready_Node *root = NULL;
+
+    while ( first != NULL )
+    {
+        Ready_Node *a = first;
+        Ready_Node *b = a->next;
+
+        if ( b != NULL )
+        {
+            first = b->next;
+            a->next = NULL;
+            b->next = NULL;
+            a = Ready_meld( a, b );
+        }
+        else
+        {
+            first = NULL;
+        }
+
+        a->next = pairs;                                // Stack the pairs to join them backwards
+        pairs = a;
+    }
+
+    while ( pairs != NULL )
+    {
+        Ready_Node *next = pairs->next;
+
+        pairs->next = NULL;
+        root = ( root == NULL ) ? pairs : Ready_meld( root, pairs );
+        pairs = next;
+    }
+
+    return root;
+}
+
+
+/**
+ * @brief   Append function
+ *
+ * Links a node at the tail of a FIFO list
+ *
+ * @param   head[in] Pointer to the head of the list
+ * @param   tail[in] Pointer to the tail of the list
+ * @param   node[in] Pointer to the node to append
+ *
+ * @retval  None
+ */
+static void Ready_append( Ready_Node **head, Ready_Node **tail, Ready_Node *node )
+{
+    if ( *tail == NULL )
+    {
+        *head = node;
+    }
+    else
+    {
+        ( *tail )->next = node;
+    }
+
+    *tail = node;
+}
+
+
+/**
+ * @brief   Init queue function
+ *
+ * Initializes an empty ready queue
+ *
+ * @param   queue[in] Pointer to a Ready_Queue variable
+ * @param   policy[in] READY_FIFO, READY_EDF or READY_PRIORITY
+ *
+ * @retval  None
+ */
+void Ready_initQueue( Ready_Queue *queue, uint8_t policy )
+{
+    queue->policy = policy;
+    queue->head = NULL;
+    queue->tail = NULL;
+    queue->count = 0;
+    queue->order = 0;
+    queue->bitmap = 0;
+
+    for ( uint32_t level = 0; level < READY_LEVELS; level++ )
+    {
+        queue->heads[ level ] = NULL;
+        queue->tails[ level ] = NULL;
+    }
+}
+
+
+/**
+ * @brief   Init node function
+ *
+ * Initializes a node as not queued
+ *
+ * @param   node[in] Pointer to a Ready_Node variable
+ *
+ * @retval  None
+ */
+void Ready_initNode( Ready_Node *node )
+{
+    node->next = NULL;
+    node->child = NULL;
+    node->queued = 0;
+}
+
+
+/**
+ * @brief   Push function
+ *
+ * Queues a node, the node must not be already queued
+ *
+ * @param   queue[in] Pointer to a Ready_Queue variable
+ * @param   node[in] Pointer to the node to queue
+ * @param   key[in] Absolute deadline of the node for READY_EDF or priority level lower than
+ *                 READY_LEVELS for READY_PRIORITY, unused by READY_FIFO
+ *
+ * @retval  None
+ */
+void Ready_push( Ready_Queue *queue, Ready_Node *node, uint32_t key )
+{
+    node->next = NULL;
+    node->child = NULL;
+    node->key = key;
+    node->order = queue->order++;
+    node->queued = 1;
+
+    if ( queue->policy == READY_EDF )
+    {
+        queue->head = ( queue->head == NULL ) ? node : Ready_meld( queue->head, node );
+    }
+    else if ( queue->policy == READY_PRIORITY )
+    {
+        Ready_append( &queue->heads[ key ], &queue->tails[ key ], node );
+        queue->bitmap |= 1ull << key;
+    }
+    else
+    {
+        Ready_append( &queue->head, &queue->tail, node );
+    }
+
+    queue->count++;
+}
+
+
+/**
+ * @brief   Pop function
+ *
+ * Takes the next node of the queue
+ *
+ * @param   queue[in] Pointer to a Ready_Queue variable
+ *
+ * @retval  Pointer to the node, NULL when the queue is empty
+ */
+Ready_Node *Ready_pop( Ready_Queue *queue )
+{
+    Ready_Node *node = queue->head;
+
+    if ( queue->count != 0 )
+    {
+        if ( queue->policy == READY_EDF )
+        {
+            queue->head = Ready_mergePairs( node->child );
+        }
+        else if ( queue->policy == READY_PRIORITY )
+        {
+            uint32_t level = (uint32_t)__builtin_ctzll( queue->bitmap );     // Highest priority with nodes
+
+            node = queue->heads[ level ];
+            queue->heads[ level ] = node->next;
+
+            if ( queue->heads[ level ] == NULL )
+            {
+                queue->tails[ level ] = NULL;
+                queue->bitmap &= ~( 1ull << level );
+            }
+        }
+        else
+        {
+            queue->head = node->next;
+
+            if ( queue->head == NULL )
+            {
+                queue->tail = NULL;
+            }
+        }
+
+        node->next = NULL;
+        node->child = NULL;
+        node->queued = 0;
+        queue->count--;
+    }
+
+    return node;
+}
+
+
+/**
+ * @brief   Is queue empty function
+ *
+ * Tells if there are no nodes on the queue
+ *
+ * @param   queue[in] Pointer to a Ready_Queue variable
+ *
+ * @retval  1 if the queue is empty, 0 otherwise
+ */
+uint8_t Ready_isQueueEmpty( Ready_Queue *queue )
+{
+    return queue->count == 0;
+}
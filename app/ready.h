@@ -0,0 +1,45 @@
+#include <stdint.h>
+
+#ifndef READY_H_
+#define READY_H_
+
+
+#define READY_FIFO      0u      /*!< nodes are taken in the order they were pushed */
+#define READY_EDF       1u      /*!< nodes are taken by earliest key (deadline) first */
+#define READY_PRIORITY  2u      /*!< nodes are taken by lowest key (priority level) first, FIFO within a level */
+
+#define READY_LEVELS    64u     /*!< number of priority levels, 0 is the highest */
+
+
+/* STRUCTURES */
+typedef struct _Ready_Node
+{
+    struct _Ready_Node *next;       /*!< next node of the FIFO list or next sibling on the heap */
+    struct _Ready_Node *child;      /*!< first child on the heap */
+    uint32_t key;                   /*!< absolute deadline used to order the heap or priority level */
+    uint32_t order;                 /*!< push sequence, breaks ties between equal keys */
+    uint8_t queued;                 /*!< 1 while the node is on a ready queue */
+} Ready_Node;
+
+
+typedef struct _Ready_Queue
+{
+    uint8_t policy;                 /*!< READY_FIFO, READY_EDF or READY_PRIORITY */
+    Ready_Node *head;               /*!< head of the FIFO list or root of the heap */
+    Ready_Node *tail;               /*!< tail of the FIFO list */
+    uint64_t bitmap;                /*!< priority levels with queued nodes */
+    Ready_Node *heads[ READY_LEVELS ];   /*!< head of the list of every priority level */
+    Ready_Node *tails[ READY_LEVELS ];   /*!< tail of the list of every priority level */
+    uint32_t count;                 /*!< number of queued nodes */
+    uint32_t order;                 /*!< push sequence counter */
+} Ready_Queue;
+
+
+void Ready_initQueue( Ready_Queue *queue, uint8_t policy );
+void Ready_initNode( Ready_Node *node );
+void Ready_push( Ready_Queue *queue, Ready_Node *node, uint32_t key );
+Ready_Node *Ready_pop( Ready_Queue *queue );
+uint8_t Ready_isQueueEmpty( Ready_Queue *queue );
+
+
+#endif
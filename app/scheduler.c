@@ -6,279 +6,4048 @@
  */
 
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         /* CPU affinity */
+#endif
+
 #include <time.h>
 #include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <unistd.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#endif
 #include "scheduler.h"
+#include "queue.h"
+#include "wheel.h"
+#include "ready.h"
+#include "pool.h"
+#include "stats.h"
+#include "trace.h"
+
+
+/**
+ * @brief Gets the timer that owns a timing wheel node
+*/
+#define SCHED_TIMER_OF( nodePtr )   ( (Sched_Timer *)( (char *)( nodePtr ) - offsetof( Sched_Timer, node ) ) )
+
+/**
+ * @brief Gets the task that owns a ready queue node
+*/
+#define SCHED_TASK_OF( nodePtr )    ( (Sched_Task *)( (char *)( nodePtr ) - offsetof( Sched_Task, readyNode ) ) )
+
+/**
+ * @brief Gets the coroutine that owns a sleep wheel node
+*/
+#define SCHED_CORO_OF( nodePtr )    ( (Sched_Coro *)( (char *)( nodePtr ) - offsetof( Sched_Coro, node ) ) )
+
+/**
+ * @brief Gets the task that owns a worker pool job
+*/
+#define SCHED_TASK_OF_JOB( jobPtr ) ( (Sched_Task *)( (char *)( jobPtr ) - offsetof( Sched_Task, job ) ) )
+
+/**
+ * @brief Nanoseconds in a microsecond
+*/
+#define SCHED_NS_PER_US     1000ull
+
+/**
+ * @brief Most ticks ahead a timer, a sleep or a deadline can be, the timing wheels and the
+ * ready queue compare 32 bit ticks relative to the current one
+*/
+#define SCHED_TICKS_MAX     0x7FFFFFFFu
+
+/**
+ * @brief Ready fds taken from every epoll wait
+*/
+#define SCHED_POLL_EVENTS   16
+
+/**
+ * @brief Bytes of stack touched before going real-time, so the loop does not fault on it
+*/
+#define SCHED_RT_STACK      ( 64u * 1024u )
+
+/**
+  * @defgroup SCHED HANDLES brief handle fields, slot number + 1 on the low bits and the slot generation on the high bits
+  @{ */
+#define SCHED_HANDLE( slot, generation )    ( ( (uint32_t)( generation ) << SCHED_HANDLE_BITS ) | ( (uint32_t)( slot ) + 1u ) )
+#define SCHED_HANDLE_SLOT( handle )         ( ( ( handle ) & SCHED_SLOTS_MAX ) - 1u )
+#define SCHED_HANDLE_GENERATION( handle )   ( ( handle ) >> SCHED_HANDLE_BITS )
+/**
+  @} */
+
+/**
+  * @defgroup SCHED WAITS brief what a coroutine waits for
+  @{ */
+#define SCHED_WAIT_NONE     0u      /*!< running or waiting to be resumed */
+#define SCHED_WAIT_SLEEP    1u      /*!< on the sleep wheel */
+#define SCHED_WAIT_TIMER    2u      /*!< on the wait list of a timer */
+#define SCHED_WAIT_QUEUE    3u      /*!< for a queue write */
+/**
+  @} */
 
 
+#ifdef __linux__
 /**
- * @brief Counting of number of timers
+ * @brief Scheduling of the thread before the real-time mode, restored when the run finishes
 */
-uint8_t timerID = 0;
+typedef struct _Sched_Saved
+{
+    int policy;                 /*!< scheduling policy */
+    struct sched_param param;   /*!< scheduling priority */
+    cpu_set_t cpus;             /*!< CPUs the thread could run on */
+} Sched_Saved;
+#endif
 
 
 /**
  * @brief   milliseconds count function
  *
- * Function to get the milliseconds the program has been running
+ * Function to get the milliseconds the program has been running. A monotonic clock is used
+ * instead of the process CPU time so the count keeps running while the scheduler sleeps
  *
  * @retval  long The number of millisecond the program has been running
  *
  */
 long milliseconds( void )
 {
-    return clock() / ( CLOCKS_PER_SEC / 1000 );
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( now.tv_sec * 1000 ) + ( now.tv_nsec / 1000000 );
+}
+
+
+/**
+ * @brief   Now function
+ *
+ * Reads the scheduler clock, the virtual clock in simulated mode or the monotonic clock
+ * otherwise
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  The scheduler time in ns
+ */
+static uint64_t Sched_now( Sched_Scheduler *scheduler )
+{
+    return scheduler->simulated ? atomic_load( &scheduler->clock ) : Stats_now();
+}
+
+
+/**
+ * @brief   Timeout function
+ *
+ * Gets the time the scheduler runs, from timeoutUs or from timeout in ms when it is 0
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  The timeout in us
+ */
+static Sched_Time Sched_timeoutOf( Sched_Scheduler *scheduler )
+{
+    return ( scheduler->timeoutUs != 0 ) ? scheduler->timeoutUs : SCHED_MS( scheduler->timeout );
+}
+
+
+/**
+ * @brief   Watchdog period function
+ *
+ * Gets the period of the watchdog, from watchdogUs or from watchdog in ms when it is 0
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  The watchdog period in us, 0 for no watchdog
+ */
+static Sched_Time Sched_watchdogOf( Sched_Scheduler *scheduler )
+{
+    return ( scheduler->watchdogUs != 0 ) ? scheduler->watchdogUs : SCHED_MS( scheduler->watchdog );
+}
+
+
+/**
+ * @brief   Wake function
+ *
+ * Wakes up the scheduler thread from its wait, it can be called from any thread
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_wake( Sched_Scheduler *scheduler )
+{
+    pthread_mutex_lock( &scheduler->lock );
+    pthread_cond_signal( &scheduler->wake );
+#ifdef __linux__
+    if ( scheduler->wakeFd >= 0 )
+    {
+        uint64_t one = 1;
+
+        (void)!write( scheduler->wakeFd, &one, sizeof( one ) );
+    }
+#endif
+    pthread_mutex_unlock( &scheduler->lock );
+}
+
+
+#ifdef __linux__
+/**
+ * @brief   Poll events function
+ *
+ * Translates scheduler fd events to epoll events
+ *
+ * @param   events[in] SCHED_FD_READ and/or SCHED_FD_WRITE
+ *
+ * @retval  The epoll events
+ */
+static uint32_t Sched_pollEvents( uint8_t events )
+{
+    return ( ( events & SCHED_FD_READ ) ? EPOLLIN : 0u ) | ( ( events & SCHED_FD_WRITE ) ? EPOLLOUT : 0u );
+}
+
+
+/**
+ * @brief   Watch function
+ *
+ * Adds an fd to the epoll instance
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   fd[in] File descriptor to watch
+ * @param   events[in] epoll events to wait for
+ * @param   data[in] Pointer given back with the events
+ *
+ * @retval  1 if the fd is watched, 0 otherwise
+ */
+static uint8_t Sched_watch( Sched_Scheduler *scheduler, int fd, uint32_t events, void *data )
+{
+    struct epoll_event event;
+
+    event.events = events;
+    event.data.ptr = data;
+
+    return epoll_ctl( scheduler->pollFd, EPOLL_CTL_ADD, fd, &event ) == 0;
+}
+
+
+/**
+ * @brief   Open poll function
+ *
+ * Creates the epoll instance with the tick timerfd, the wake eventfd and the registered fds
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_openPoll( Sched_Scheduler *scheduler )
+{
+    int pollFd = epoll_create1( EPOLL_CLOEXEC );
+    int tickFd = timerfd_create( CLOCK_MONOTONIC, TFD_CLOEXEC | TFD_NONBLOCK );
+    int wakeFd = eventfd( 0, EFD_CLOEXEC | EFD_NONBLOCK );
+
+    if ( ( pollFd >= 0 ) && ( tickFd >= 0 ) && ( wakeFd >= 0 ) )
+    {
+        scheduler->pollFd = pollFd;
+        scheduler->tickFd = tickFd;
+        Sched_watch( scheduler, tickFd, EPOLLIN, &scheduler->tickFd );
+        Sched_watch( scheduler, wakeFd, EPOLLIN, &scheduler->wakeFd );
+
+        for ( uint32_t i = 0; i < scheduler->sources; i++ )
+        {
+            Sched_Source *source = scheduler->sourcePtr + i;
+
+            if ( source->used )
+            {
+                Sched_watch( scheduler, source->fd, Sched_pollEvents( source->events ), source );
+            }
+        }
+
+        pthread_mutex_lock( &scheduler->lock );
+        scheduler->wakeFd = wakeFd;                     // Queue writes wake up the epoll wait from now on
+        pthread_mutex_unlock( &scheduler->lock );
+    }
+    else
+    {
+        if ( pollFd >= 0 ) close( pollFd );            // Keep waiting without epoll
+        if ( tickFd >= 0 ) close( tickFd );
+        if ( wakeFd >= 0 ) close( wakeFd );
+    }
+}
+
+
+/**
+ * @brief   Close poll function
+ *
+ * Closes the epoll instance and its timerfd and eventfd, the registered fds are kept
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_closePoll( Sched_Scheduler *scheduler )
+{
+    if ( scheduler->pollFd >= 0 )
+    {
+        pthread_mutex_lock( &scheduler->lock );
+        close( scheduler->wakeFd );
+        scheduler->wakeFd = -1;
+        pthread_mutex_unlock( &scheduler->lock );
+
+        close( scheduler->tickFd );
+        close( scheduler->pollFd );
+        scheduler->tickFd = -1;
+        scheduler->pollFd = -1;
+    }
+}
+
+
+/**
+ * @brief   Poll until function
+ *
+ * Arms the timerfd for the given time and blocks on the epoll instance, the callbacks of the
+ * ready fds are called meanwhile. Returns once the timerfd expires or a queue with a listening
+ * task or coroutine is written
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   until[in] Monotonic time in ns to wake up at
+ *
+ * @retval  1 if there are tasks or coroutines released by queue writes, 0 otherwise
+ */
+static uint8_t Sched_pollUntil( Sched_Scheduler *scheduler, uint64_t until )
+{
+    struct itimerspec wake = { 0 };
+    uint8_t tick = 0;
+
+    wake.it_value.tv_sec = (time_t)( until / 1000000000ull );
+    wake.it_value.tv_nsec = (long)( until % 1000000000ull );
+    timerfd_settime( scheduler->tickFd, TFD_TIMER_ABSTIME, &wake, NULL );
+
+    while ( ( tick == 0 ) && ( atomic_load( &scheduler->events ) == NULL ) && ( atomic_load( &scheduler->coroEvents ) == NULL ) )
+    {
+        struct epoll_event ready[ SCHED_POLL_EVENTS ];
+        int count = epoll_wait( scheduler->pollFd, ready, SCHED_POLL_EVENTS, -1 );
+
+        for ( int i = 0; i < count; i++ )
+        {
+            void *data = ready[ i ].data.ptr;
+            uint64_t value;
+
+            if ( data == &scheduler->tickFd )
+            {
+                tick = ( read( scheduler->tickFd, &value, sizeof( value ) ) > 0 );
+            }
+            else if ( data == &scheduler->wakeFd )
+            {
+                (void)!read( scheduler->wakeFd, &value, sizeof( value ) );     // The event lists tell what was written
+            }
+            else
+            {
+                Sched_Source *source = data;
+                uint32_t events = ready[ i ].events;
+                uint8_t fdEvents = ( ( events & EPOLLIN ) ? SCHED_FD_READ : 0u ) | ( ( events & EPOLLOUT ) ? SCHED_FD_WRITE : 0u ) |
+                                   ( ( events & ( EPOLLERR | EPOLLHUP ) ) ? SCHED_FD_ERROR : 0u );
+
+                if ( source->used )                     // An earlier callback may have unregistered it
+                {
+                    Stats_addLoad( &scheduler->load, Stats_now(), 0 );
+                    source->callbackPtr( source->fd, fdEvents );
+                    Stats_addLoad( &scheduler->load, Stats_now(), 1 );
+                }
+            }
+        }
+    }
+
+    return ( atomic_load( &scheduler->events ) != NULL ) || ( atomic_load( &scheduler->coroEvents ) != NULL );
+}
+#endif
+
+
+/**
+ * @brief   Wait until function
+ *
+ * Waits until the monotonic clock reaches the given time or a queue with a listening task or
+ * coroutine is written. In simulated mode the virtual clock jumps to the given time at once.
+ * With fd sources the thread blocks on epoll, in tickless mode it sleeps, otherwise it busy
+ * waits like the tick loop
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   until[in] Monotonic time in ns to wake up at
+ *
+ * @retval  1 if there are tasks or coroutines released by queue writes, 0 otherwise
+ */
+static uint8_t Sched_waitUntil( Sched_Scheduler *scheduler, uint64_t until )
+{
+    if ( scheduler->simulated )
+    {
+        uint8_t events = ( atomic_load( &scheduler->events ) != NULL ) || ( atomic_load( &scheduler->coroEvents ) != NULL );
+
+        if ( ( events == 0 ) && ( atomic_load( &scheduler->clock ) < until ) )
+        {
+            atomic_store( &scheduler->clock, until );   // Nothing to wait for in virtual time
+        }
+
+        return events;
+    }
+
+#ifdef __linux__
+    if ( scheduler->pollFd >= 0 )
+    {
+        return Sched_pollUntil( scheduler, until );
+    }
+#endif
+
+    if ( scheduler->tickless )
+    {
+        struct timespec wake;
+
+        wake.tv_sec = (time_t)( until / 1000000000ull );
+        wake.tv_nsec = (long)( until % 1000000000ull );
+
+        pthread_mutex_lock( &scheduler->lock );
+
+        while ( ( atomic_load( &scheduler->events ) == NULL ) && ( atomic_load( &scheduler->coroEvents ) == NULL ) && ( Stats_now() < until ) )
+        {
+            pthread_cond_timedwait( &scheduler->wake, &scheduler->lock, &wake );
+        }
+
+        pthread_mutex_unlock( &scheduler->lock );
+    }
+    else
+    {
+        while ( ( atomic_load( &scheduler->events ) == NULL ) && ( atomic_load( &scheduler->coroEvents ) == NULL ) && ( Stats_now() < until ) )
+        {
+            // Wait tick seconds
+        }
+    }
+
+    return ( atomic_load( &scheduler->events ) != NULL ) || ( atomic_load( &scheduler->coroEvents ) != NULL );
+}
+
+
+/**
+ * @brief   Idle until function
+ *
+ * Accounts the time up to now as busy, runs the idle hook if there is no work due and waits
+ * until the given time or a queue write, that time is accounted as idle
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   until[in] Time in ns to wake up at
+ *
+ * @retval  1 if there are tasks or coroutines released by queue writes, 0 otherwise
+ */
+static uint8_t Sched_idleUntil( Sched_Scheduler *scheduler, uint64_t until )
+{
+    uint8_t exit;
+
+    Stats_addLoad( &scheduler->load, Sched_now( scheduler ), 1 );
+
+    if ( ( scheduler->idlePtr != NULL ) && Ready_isQueueEmpty( &scheduler->ready ) && ( scheduler->retry == NULL ) && ( scheduler->resumeHead == NULL ) &&
+         ( atomic_load( &scheduler->events ) == NULL ) && ( atomic_load( &scheduler->coroEvents ) == NULL ) && ( Sched_now( scheduler ) < until ) )
+    {
+        scheduler->idlePtr();                           // Background work, it counts as idle time
+    }
+
+    exit = Sched_waitUntil( scheduler, until );
+    Stats_addLoad( &scheduler->load, Sched_now( scheduler ), 0 );
+
+    return exit;
+}
+
+
+/**
+ * @brief   Is periodic function
+ *
+ * Tells if a task is released on its period slots, not by a queue or the tasks it depends on
+ *
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  1 for a registered periodic task, 0 otherwise
+ */
+static uint8_t Sched_isPeriodic( Sched_Task *task )
+{
+    return task->used && ( task->queue == NULL ) && ( task->depends == 0 );
+}
+
+
+/**
+ * @brief   Next frame function
+ *
+ * Gets the ticks to the next frame of the cyclic table with tasks
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  The ticks to the next frame with tasks, UINT64_MAX if every frame is empty
+ */
+static uint64_t Sched_nextFrame( Sched_Scheduler *scheduler )
+{
+    uint64_t minor = scheduler->minorTicks;
+    uint64_t tick = ( ( scheduler->ticksCount / minor ) + 1u ) * minor;
+    uint64_t exit = UINT64_MAX;
+
+    for ( uint32_t n = 0; ( n < scheduler->cyclicFrames ) && ( exit == UINT64_MAX ); n++ )
+    {
+        uint32_t f = (uint32_t)( ( tick / minor ) % scheduler->cyclicFrames );
+
+        if ( scheduler->cyclicPtr[ f + 1u ] != scheduler->cyclicPtr[ f ] )
+        {
+            exit = tick - scheduler->ticksCount;
+        }
+
+        tick += minor;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Next deadline function
+ *
+ * Computes how many ticks the scheduler can sleep before a task, a timer or a sleeping
+ * coroutine is due or the last tick to run is reached. A task is due on its next release slot, the static task
+ * table on the next slot of any of its tasks and a timer once its count reaches zero
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   last[in] Last tick to run, after the current one
+ *
+ * @retval  The number of ticks until the next loop iteration with work to do, at least 1
+ */
+static uint32_t Sched_nextDeadline( Sched_Scheduler *scheduler, uint64_t last )
+{
+    Sched_Time tick = scheduler->base;
+    Sched_Time now = scheduler->ticksCount * tick;
+    uint32_t steps = ( last - scheduler->ticksCount < SCHED_TICKS_MAX ) ? (uint32_t)( last - scheduler->ticksCount ) : SCHED_TICKS_MAX;
+    uint8_t framed = scheduler->cyclic && ( scheduler->cyclicFrames != 0 ) && ( scheduler->cyclicDirty == 0 );    // Frames replace the task scan
+
+    if ( ( Ready_isQueueEmpty( &scheduler->ready ) == 0 ) || ( scheduler->retry != NULL ) || ( scheduler->resumeHead != NULL ) )
+    {
+        steps = 1;                                      // Tasks still waiting to run
+    }
+
+    if ( framed )
+    {
+        steps = ( Sched_nextFrame( scheduler ) < steps ) ? (uint32_t)Sched_nextFrame( scheduler ) : steps;     // Next frame with tasks
+    }
+
+    for ( uint32_t i = 0; ( i < scheduler->tasksCount ) && ( framed == 0 ); i++ )
+    {
+        Sched_Task *actual_task = scheduler->taskPtr + i;
+        Sched_Time slot = actual_task->absLastTime + actual_task->period;        // Next slot
+        uint64_t due = 1;
+
+        if ( Sched_isPeriodic( actual_task ) && actual_task->startFlag )
+        {
+            if ( slot > now )
+            {
+                due = ( slot - now + tick - 1u ) / tick;
+            }
+
+            if ( due < steps )
+            {
+                steps = (uint32_t)due;
+            }
+        }
+    }
+
+    if ( ( scheduler->table != NULL ) && ( scheduler->table->nextPtr( scheduler->ticksCount ) < steps ) )
+    {
+        steps = scheduler->table->nextPtr( scheduler->ticksCount );     // Next release of the static task table
+    }
+
+    steps = Wheel_nextEvent( &scheduler->wheel, steps - 1 ) + 1;      // Next tick with timers to expire
+    steps = Wheel_nextEvent( &scheduler->sleeps, steps - 1 ) + 1;     // Next tick with coroutines to wake up
+
+    return steps;
+}
+
+
+/**
+ * @brief   Coalesce function
+ *
+ * Gets the tick a timer fires on within its slack window. The tick is rounded up to a
+ * multiple of the biggest power of two that fits in the window, so timers whose windows
+ * overlap land on the same tick and share one wakeup
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   timer[in] Pointer to the timer
+ * @param   due[in] Tick the timer is due on
+ *
+ * @retval  The tick to fire on, from due to due plus the slack
+ */
+static uint32_t Sched_coalesce( Sched_Scheduler *scheduler, Sched_Timer *timer, uint32_t due )
+{
+    uint32_t slack = ( timer->slack / scheduler->base < SCHED_TICKS_MAX ) ? (uint32_t)( timer->slack / scheduler->base ) : SCHED_TICKS_MAX;
+    uint32_t grain = 1;
+
+    if ( slack != 0 )
+    {
+        grain = 1u << ( 31u - (uint32_t)__builtin_clz( slack + 1u ) );
+    }
+
+    return due + ( ( 0u - due ) & ( grain - 1u ) );
+}
+
+
+/**
+ * @brief   Arm timer function
+ *
+ * Links a timer to the timing wheel to expire once its count is over
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   timer[in] Pointer to the timer to arm
+ *
+ * @retval  None
+ */
+static void Sched_armTimer( Sched_Scheduler *scheduler, Sched_Timer *timer )
+{
+    timer->due = scheduler->wheel.now + (uint32_t)( timer->count / scheduler->base );      // Checked to fit when the timeout was set
+
+    Wheel_remove( &scheduler->wheel, &timer->node );
+    Wheel_insert( &scheduler->wheel, &timer->node, Sched_coalesce( scheduler, timer, timer->due ) );
+}
+
+
+/**
+ * @brief   Sync timer function
+ *
+ * Refreshes the count of a running timer from the timing wheel
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   timer[in] Pointer to the timer to refresh
+ *
+ * @retval  None
+ */
+static void Sched_syncTimer( Sched_Scheduler *scheduler, Sched_Timer *timer )
+{
+    if ( Wheel_isLinked( &timer->node ) )
+    {
+        uint32_t ticks = timer->due - scheduler->wheel.now;
+
+        timer->count = ( (int32_t)ticks > 0 ) ? (Sched_Time)ticks * scheduler->base : 0;
+    }
+}
+
+/**
+ * @brief   Tick time function
+ *
+ * Computes the monotonic time a tick was due
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   tick[in] Tick number
+ *
+ * @retval  The monotonic time in ns
+ */
+static uint64_t Sched_tickTime( Sched_Scheduler *scheduler, uint64_t tick )
+{
+    return scheduler->epoch + ( tick * scheduler->base * SCHED_NS_PER_US );
+}
+
+
+/**
+ * @brief   Resume coroutine function
+ *
+ * Puts a coroutine at the end of the list of coroutines to resume
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   coro[in] Pointer to the coroutine
+ *
+ * @retval  None
+ */
+static void Sched_resumeCoro( Sched_Scheduler *scheduler, Sched_Coro *coro )
+{
+    coro->wait = SCHED_WAIT_NONE;
+    coro->next = NULL;
+
+    if ( scheduler->resumeTail == NULL )
+    {
+        scheduler->resumeHead = coro;
+    }
+    else
+    {
+        scheduler->resumeTail->next = coro;
+    }
+
+    scheduler->resumeTail = coro;
+}
+
+
+/**
+ * @brief   Wake waiters function
+ *
+ * Resumes every coroutine waiting for a timer
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   timer[in] Pointer to the timer
+ *
+ * @retval  None
+ */
+static void Sched_wakeWaiters( Sched_Scheduler *scheduler, Sched_Timer *timer )
+{
+    while ( timer->waiters != NULL )
+    {
+        Sched_Coro *coro = timer->waiters;
+
+        timer->waiters = coro->next;
+        Sched_resumeCoro( scheduler, coro );
+    }
+}
+
+
+/**
+ * @brief   Expire sleeps function
+ *
+ * Processes the sleep wheel up to the given tick and resumes the coroutines that slept
+ * enough, ticks without coroutines to wake up are skipped
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   target[in] Last tick to process
+ *
+ * @retval  None
+ */
+static void Sched_expireSleeps( Sched_Scheduler *scheduler, uint32_t target )
+{
+    Wheel *wheel = &scheduler->sleeps;
+
+    while ( (int32_t)( target - wheel->now ) >= 0 )
+    {
+        Wheel_skip( wheel, Wheel_nextEvent( wheel, target - wheel->now ) );
+        Wheel_advance( wheel );
+
+        for ( Wheel_Node *node = Wheel_popExpired( wheel ); node != NULL; node = Wheel_popExpired( wheel ) )
+        {
+            Sched_resumeCoro( scheduler, SCHED_CORO_OF( node ) );
+        }
+    }
+}
+
+
+/**
+ * @brief   Notify coroutine function
+ *
+ * Queue listener of the coroutines, it can be called from any thread. The coroutine goes on
+ * the event list once until the scheduler takes it and the scheduler is woken up
+ *
+ * @param   listener[in] Pointer to the coroutine
+ *
+ * @retval  None
+ */
+static void Sched_notifyCoro( void *listener )
+{
+    Sched_Coro *coro = listener;
+    Sched_Scheduler *scheduler = coro->scheduler;
+
+    if ( atomic_exchange( &coro->triggered, 1 ) == 0 )
+    {
+        Sched_Coro *head = atomic_load( &scheduler->coroEvents );
+
+        do
+        {
+            coro->nextEvent = head;
+        } while ( atomic_compare_exchange_weak( &scheduler->coroEvents, &head, coro ) == 0 );
+
+        Sched_wake( scheduler );
+    }
+
+    if ( coro->prevNotify != NULL )
+    {
+        coro->prevNotify( coro->prevListener );        // Listeners it is chained to
+    }
+}
+
+
+/**
+ * @brief   Unlisten queue function
+ *
+ * Takes a listener out of the chain of a queue, the coroutines listening on top of it call
+ * the listener it was chained to from then on
+ *
+ * @param   queue[in] Pointer to the queue
+ * @param   listener[in] Listener to take out
+ * @param   prevNotify[in] Function of the listener it was chained to, NULL for none
+ * @param   prevListener[in] Listener it was chained to
+ *
+ * @retval  None
+ */
+static void Sched_unlistenQueue( Que_Queue *queue, void *listener, void (*prevNotify)( void *listener ), void *prevListener )
+{
+    if ( queue->Listener == listener )
+    {
+        Queue_setListener( queue, prevNotify, prevListener );
+    }
+    else if ( queue->Notify == Sched_notifyCoro )
+    {
+        Sched_Coro *coro = queue->Listener;
+
+        while ( ( coro->prevListener != listener ) && ( coro->prevNotify == Sched_notifyCoro ) )
+        {
+            coro = coro->prevListener;
+        }
+
+        if ( coro->prevListener == listener )
+        {
+            coro->prevNotify = prevNotify;
+            coro->prevListener = prevListener;
+        }
+    }
+}
+
+
+/**
+ * @brief   Free coroutine function
+ *
+ * Puts a finished coroutine slot on the free list
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   coro[in] Pointer to the coroutine
+ *
+ * @retval  None
+ */
+static void Sched_freeCoro( Sched_Scheduler *scheduler, Sched_Coro *coro )
+{
+    if ( coro->queue != NULL )
+    {
+        Sched_unlistenQueue( coro->queue, coro, coro->prevNotify, coro->prevListener );
+    }
+
+    coro->used = 0;
+    coro->next = scheduler->freeCoro;
+    scheduler->freeCoro = coro;
+}
+
+
+/**
+ * @brief   Resume coroutines function
+ *
+ * Resumes the coroutines that stopped waiting, a coroutine resumed again while this runs
+ * waits for the next call. Finished coroutines go to the free list
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_resumeCoros( Sched_Scheduler *scheduler )
+{
+    Sched_Coro *last = scheduler->resumeTail;
+    Sched_Coro *coro = NULL;
+
+    while ( ( coro != last ) && ( scheduler->resumeHead != NULL ) )
+    {
+        coro = scheduler->resumeHead;
+        scheduler->resumeHead = coro->next;
+
+        if ( scheduler->resumeHead == NULL )
+        {
+            scheduler->resumeTail = NULL;
+        }
+
+        coro->func( coro );                             // Runs until its next wait or its end
+
+        if ( coro->line == SCHED_CORO_DONE )
+        {
+            Sched_freeCoro( scheduler, coro );
+        }
+    }
+}
+
+
+/**
+ * @brief   Call timer function
+ *
+ * Calls the callback of an expired timer
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   timer[in] Pointer to the timer
+ * @param   expirations[in] Expirations since the last call
+ *
+ * @retval  None
+ */
+static void Sched_callTimer( Sched_Scheduler *scheduler, Sched_Timer *timer, uint32_t expirations )
+{
+    uint32_t slot = (uint32_t)( timer - scheduler->timerPtr );
+
+    TRACE_EVENT( TRACE_TIMER_BEGIN, slot );
+
+    if ( timer->expiredPtr != NULL )
+    {
+        timer->expiredPtr( expirations );
+    }
+    else
+    {
+        timer->callbackPtr();
+    }
+
+    TRACE_EVENT( TRACE_TIMER_END, slot );
+}
+
+
+/**
+ * @brief   Expire timers function
+ *
+ * Processes the timing wheel up to the given tick, ticks without timers are skipped. Expired
+ * hold timers fire on every processed tick until they are reloaded or stopped, one-shot
+ * timers stop and periodic timers are rearmed from their expiry tick, firing once for the
+ * periods up to the given tick. The coroutines waiting for them are resumed
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   target[in] Last tick to process
+ *
+ * @retval  None
+ */
+static void Sched_expireTimers( Sched_Scheduler *scheduler, uint32_t target )
+{
+    Wheel *wheel = &scheduler->wheel;
+
+    while ( (int32_t)( target - wheel->now ) >= 0 )
+    {
+        Wheel_skip( wheel, Wheel_nextEvent( wheel, target - wheel->now ) );
+        Wheel_advance( wheel );
+
+        for ( Wheel_Node *node = Wheel_popExpired( wheel ); node != NULL; node = Wheel_popExpired( wheel ) )
+        {
+            Sched_Timer *actual_timer = SCHED_TIMER_OF( node );
+            uint32_t expired = actual_timer->due;       // Tick it was due on, the slack may have delayed it
+            uint32_t expirations = 1;
+
+            actual_timer->count = 0;
+
+            if ( actual_timer->mode == SCHED_TIMER_PERIODIC )
+            {
+                uint32_t period = (uint32_t)( actual_timer->timeout / scheduler->base );
+
+                expirations += ( target - expired ) / period;        // Periods the scheduler jumped over
+                actual_timer->due = expired + ( expirations * period );
+                Wheel_insert( wheel, node, Sched_coalesce( scheduler, actual_timer, actual_timer->due ) );
+            }
+            else if ( actual_timer->mode == SCHED_TIMER_ONESHOT )
+            {
+                actual_timer->startFlag = 0;
+            }
+            else
+            {
+                Sched_armTimer( scheduler, actual_timer );
+            }
+
+            if ( actual_timer->stats != NULL )
+            {
+                uint64_t start = Sched_now( scheduler );
+                uint64_t begin = Stats_now();
+
+                Sched_callTimer( scheduler, actual_timer, expirations );
+                Stats_addRun( actual_timer->stats, Sched_tickTime( scheduler, scheduler->ticksCount - ( target - expired ) ), start, start + ( Stats_now() - begin ), actual_timer->timeout * SCHED_NS_PER_US );
+            }
+            else
+            {
+                Sched_callTimer( scheduler, actual_timer, expirations );
+            }
+
+            Sched_wakeWaiters( scheduler, actual_timer );
+        }
+    }
+}
+
+
+/**
+ * @brief   Align task function
+ *
+ * Moves the last release slot of a task to the latest slot not after the current tick, so
+ * the periods a stopped task did not run are not taken as missed
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task to align
+ *
+ * @retval  None
+ */
+static void Sched_alignTask( Sched_Scheduler *scheduler, Sched_Task *task )
+{
+    Sched_Time now = scheduler->ticksCount * scheduler->base;
+
+    if ( now > task->absLastTime )
+    {
+        task->absLastTime += ( ( now - task->absLastTime ) / task->period ) * task->period;
+    }
+}
+
+
+/**
+ * @brief   Task of function
+ *
+ * Gets the task slot a handle refers to, the handle has to be in the range of the task buffer
+ * and carry the current generation of the slot
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Task handle
+ *
+ * @retval  Pointer to the task, NULL if the handle is not valid
+ */
+static Sched_Task *Sched_taskOf( Sched_Scheduler *scheduler, uint32_t task )
+{
+    uint32_t slot = SCHED_HANDLE_SLOT( task );
+    Sched_Task *exit = NULL;
+
+    if ( ( slot < scheduler->tasks ) && ( scheduler->taskPtr[ slot ].generation == SCHED_HANDLE_GENERATION( task ) ) )
+    {
+        exit = scheduler->taskPtr + slot;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Timer of function
+ *
+ * Gets the timer slot a handle refers to, the handle has to be in the range of the timer
+ * buffer and carry the current generation of the slot
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   timer[in] Timer handle
+ *
+ * @retval  Pointer to the timer, NULL if the handle is not valid
+ */
+static Sched_Timer *Sched_timerOf( Sched_Scheduler *scheduler, uint32_t timer )
+{
+    uint32_t slot = SCHED_HANDLE_SLOT( timer );
+    Sched_Timer *exit = NULL;
+
+    if ( ( slot < scheduler->timers ) && ( scheduler->timerPtr[ slot ].generation == SCHED_HANDLE_GENERATION( timer ) ) )
+    {
+        exit = scheduler->timerPtr + slot;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Alloc task function
+ *
+ * Takes a task slot from the free list or, if it is empty, the next slot never handed out.
+ * A slot whose last run is still on the worker pool is not reused yet
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  Pointer to the task slot, NULL if there are no slots left
+ */
+static Sched_Task *Sched_allocTask( Sched_Scheduler *scheduler )
+{
+    Sched_Task *task = NULL;
+
+    if ( ( scheduler->freeTask != 0 ) && ( atomic_load( &scheduler->taskPtr[ scheduler->freeTask - 1u ].job.busy ) == 0 ) )
+    {
+        task = scheduler->taskPtr + scheduler->freeTask - 1u;
+        scheduler->freeTask = task->nextFree;
+    }
+    else if ( ( scheduler->tasksCount < scheduler->tasks ) && ( scheduler->tasksCount < SCHED_SLOTS_MAX ) )
+    {
+        task = scheduler->taskPtr + scheduler->tasksCount++;
+    }
+
+    return task;
+}
+
+
+/**
+ * @brief   Free task function
+ *
+ * Puts a task slot on the free list
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task slot
+ *
+ * @retval  None
+ */
+static void Sched_freeTask( Sched_Scheduler *scheduler, Sched_Task *task )
+{
+    task->nextFree = scheduler->freeTask;
+    scheduler->freeTask = (uint32_t)( task - scheduler->taskPtr ) + 1u;
+}
+
+
+/**
+ * @brief   Overrun function
+ *
+ * Reports the current run of a task over its budget, only once per run. It is called from
+ * the watchdog thread while the task still runs or from the thread that ran it
+ *
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  None
+ */
+static void Sched_overrunTask( Sched_Task *task )
+{
+    if ( atomic_exchange( &task->overran, 1 ) == 0 )
+    {
+        if ( task->stats != NULL )
+        {
+            Stats_addExceeded( task->stats );
+        }
+
+        void (*overrunPtr)( uint32_t task ) = atomic_load( &task->overrunPtr );
+
+        if ( overrunPtr != NULL )
+        {
+            overrunPtr( SCHED_HANDLE( task - task->scheduler->taskPtr, task->generation ) );
+        }
+    }
+}
+
+
+/**
+ * @brief   Watchdog thread function
+ *
+ * Checks every watchdog period the tasks that are running, the ones that have been running
+ * for longer than their budget are reported while they still run
+ *
+ * @param   arg[in] Pointer to the Sched_Scheduler
+ *
+ * @retval  NULL
+ */
+static void *Sched_watchdogThread( void *arg )
+{
+    Sched_Scheduler *scheduler = arg;
+    uint64_t wake = Stats_now();
+
+    pthread_mutex_lock( &scheduler->lock );
+
+    while ( scheduler->watchdogStop == 0 )
+    {
+        struct timespec until;
+
+        wake += Sched_watchdogOf( scheduler ) * SCHED_NS_PER_US;
+        until.tv_sec = (time_t)( wake / 1000000000ull );
+        until.tv_nsec = (long)( wake % 1000000000ull );
+
+        while ( ( scheduler->watchdogStop == 0 ) && ( Stats_now() < wake ) )
+        {
+            pthread_cond_timedwait( &scheduler->watchdogWake, &scheduler->lock, &until );
+        }
+
+        pthread_mutex_unlock( &scheduler->lock );
+
+        for ( uint32_t i = 0; i < atomic_load( &scheduler->tasksWatched ); i++ )       // Slots registered so far, the scheduler thread can add more
+        {
+            Sched_Task *task = scheduler->taskPtr + i;
+            uint64_t now = Stats_now();                         // Read before the start, so a start still set is of a run going on at now
+            uint64_t started = atomic_load( &task->started );
+            Sched_Time budget = atomic_load( &task->budget );
+
+            if ( ( budget != 0 ) && ( started != 0 ) && ( now > started ) && ( now - started > (uint64_t)budget * 1000u ) )
+            {
+                Sched_overrunTask( task );
+            }
+        }
+
+        pthread_mutex_lock( &scheduler->lock );
+    }
+
+    pthread_mutex_unlock( &scheduler->lock );
+
+    return NULL;
+}
+
+
+/**
+ * @brief   Stop overrun function
+ *
+ * Stops a task whose last run went over its budget, if the task asks for it, once the run
+ * returned. Only the scheduler thread changes startFlag, the worker running the task just
+ * leaves the overrun flagged
+ *
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  None
+ */
+static void Sched_stopOverrun( Sched_Task *task )
+{
+    if ( ( task->overrunAction == SCHED_OVERRUN_STOP ) && ( atomic_load( &task->started ) == 0 ) && atomic_load( &task->overran ) )
+    {
+        task->startFlag = 0;
+        atomic_store( &task->overran, 0 );              // Starting it again does not stop it again
+    }
+}
+
+
+/**
+ * @brief   Snap task function
+ *
+ * Takes the release times of the run being dispatched, the run reads them on the worker while
+ * the scheduler thread releases the task again
+ *
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  None
+ */
+static void Sched_snapTask( Sched_Task *task )
+{
+    task->runRelease = task->releaseTime;
+    task->runOrigin = ( task->depends != 0 ) ? task->activated : task->releaseTime;
+}
+
+
+/**
+ * @brief   Run task function
+ *
+ * Runs a task function and records its execution statistics if the task has them. A task
+ * with a budget is timed too, a run over it is reported and stays flagged in overran, the
+ * scheduler thread stops the task once it returns if the task asks for it
+ *
+ * @param   task[in] Pointer to the task to run
+ *
+ * @retval  None
+ */
+static void Sched_runTask( Sched_Task *task )
+{
+    uint32_t slot = (uint32_t)( task - task->scheduler->taskPtr );
+
+    TRACE_EVENT( TRACE_TASK_BEGIN, slot );
+
+    Sched_Time budget = atomic_load( &task->budget );
+
+    if ( ( task->stats != NULL ) || ( budget != 0 ) )
+    {
+        uint64_t start = Sched_now( task->scheduler );
+        uint64_t begin = Stats_now();
+        uint64_t run;
+
+        atomic_store( &task->overran, 0 );
+        atomic_store( &task->started, begin );              // The watchdog can see the run from now on
+        task->taskFunc();
+        run = Stats_now() - begin;
+        atomic_store( &task->started, 0 );
+
+        if ( task->stats != NULL )
+        {
+            Stats_addRun( task->stats, task->runRelease, start, start + run, task->period * SCHED_NS_PER_US );
+        }
+
+        budget = atomic_load( &task->budget );             // The budget in force once it returns, it can change while it runs
+
+        if ( ( budget != 0 ) && ( run > (uint64_t)budget * 1000u ) )
+        {
+            Sched_overrunTask( task );                      // Finished before the watchdog looked
+        }
+    }
+    else
+    {
+        task->taskFunc();
+    }
+
+    TRACE_EVENT( TRACE_TASK_END, slot );
+}
+
+
+/**
+ * @brief   Drop task function
+ *
+ * Puts an unregistered task slot on the free list once it is neither on the ready queue nor
+ * on the event list
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task slot
+ *
+ * @retval  None
+ */
+static void Sched_dropTask( Sched_Scheduler *scheduler, Sched_Task *task )
+{
+    if ( ( task->used == 0 ) && ( task->readyNode.queued == 0 ) && ( atomic_load( &task->triggered ) == 0 ) )
+    {
+        Sched_freeTask( scheduler, task );
+    }
+}
+
+
+/**
+ * @brief   Member function
+ *
+ * Gets a task of the set under analysis, the registered tasks plus an extra one
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   extra[in] Task not registered yet to add to the set, NULL for none
+ * @param   i[in] Index from 0 to tasksCount, tasksCount is the extra task
+ *
+ * @retval  Pointer to the task, NULL if the index is not part of the set
+ */
+static Sched_Task *Sched_memberOf( Sched_Scheduler *scheduler, Sched_Task *extra, uint32_t i )
+{
+    Sched_Task *task = extra;
+
+    if ( i < scheduler->tasksCount )
+    {
+        task = ( scheduler->taskPtr[ i ].used ) ? ( scheduler->taskPtr + i ) : NULL;
+    }
+
+    return task;
+}
+
+
+/**
+ * @brief   Analysis deadline function
+ *
+ * Gets the deadline a task is analysed with, its relative deadline capped at its period
+ *
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  The deadline in us
+ */
+static Sched_Time Sched_limitOf( Sched_Task *task )
+{
+    return ( ( task->deadline != 0 ) && ( task->deadline < task->period ) ) ? task->deadline : task->period;
+}
+
+
+/**
+ * @brief   Interferes function
+ *
+ * Tells whether a task can run before another one released at the same time, every other
+ * task under FIFO and the higher or equal priorities under the priority policy
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   other[in] Pointer to the task that may run first
+ * @param   task[in] Pointer to the task being analysed
+ *
+ * @retval  1 if other can delay task more than once, 0 otherwise
+ */
+static uint8_t Sched_interferes( Sched_Scheduler *scheduler, Sched_Task *other, Sched_Task *task )
+{
+    uint8_t exit = ( other != task );
+
+    if ( scheduler->ready.policy == SCHED_POLICY_PRIORITY )
+    {
+        exit = exit && ( other->priority <= task->priority );
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Window function
+ *
+ * Gets the time from the critical instant to the start of the first job of a task, the
+ * blocking plus every interfering job released up to that start, so it is found by fixed
+ * point iteration
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   extra[in] Task not registered yet to add to the set, NULL for none
+ * @param   task[in] Pointer to the task being analysed
+ * @param   blocking[in] Blocking time in us
+ *
+ * @retval  The start time in us, beyond the deadline once it can not be met
+ */
+static Sched_Time Sched_windowOf( Sched_Scheduler *scheduler, Sched_Task *extra, Sched_Task *task, Sched_Time blocking )
+{
+    Sched_Time limit = Sched_limitOf( task );
+    Sched_Time window;
+    Sched_Time next = blocking;
+
+    do
+    {
+        window = next;
+        next = blocking;
+
+        for ( uint32_t i = 0; i <= scheduler->tasksCount; i++ )
+        {
+            Sched_Task *other = Sched_memberOf( scheduler, extra, i );
+
+            if ( ( other != NULL ) && Sched_interferes( scheduler, other, task ) )
+            {
+                next += ( ( window / other->period ) + 1u ) * other->wcet;
+            }
+        }
+    } while ( ( next != window ) && ( next + task->wcet <= limit ) );
+
+    return next;
+}
+
+
+/**
+ * @brief   Response time function
+ *
+ * Runs the non-preemptive response time analysis of a task. Tasks run to completion, so the
+ * task is blocked by the longest job that can not interfere with it. When the busy period
+ * of the task ends before its next release the first job is the worst one, otherwise the
+ * sufficient test that also counts the task as its own blocking is used
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   extra[in] Task not registered yet to add to the set, NULL for none
+ * @param   task[in] Pointer to the task being analysed
+ *
+ * @retval  1 if the worst case response time is within the deadline, 0 otherwise
+ */
+static uint8_t Sched_responds( Sched_Scheduler *scheduler, Sched_Task *extra, Sched_Task *task )
+{
+    Sched_Time period = task->period;
+    Sched_Time blocking = 0;
+    Sched_Time busy;
+    Sched_Time next;
+
+    for ( uint32_t i = 0; i <= scheduler->tasksCount; i++ )
+    {
+        Sched_Task *other = Sched_memberOf( scheduler, extra, i );
+
+        if ( ( other != NULL ) && ( other != task ) && ( Sched_interferes( scheduler, other, task ) == 0 ) && ( other->wcet > blocking ) )
+        {
+            blocking = other->wcet;
+        }
+    }
+
+    next = blocking + task->wcet;
+
+    do
+    {
+        busy = next;
+        next = blocking;
+
+        for ( uint32_t i = 0; i <= scheduler->tasksCount; i++ )
+        {
+            Sched_Task *other = Sched_memberOf( scheduler, extra, i );
+
+            if ( ( other != NULL ) && ( ( other == task ) || Sched_interferes( scheduler, other, task ) ) )
+            {
+                next += ( ( busy + other->period - 1u ) / other->period ) * other->wcet;
+            }
+        }
+    } while ( ( next != busy ) && ( next <= period ) );
+
+    if ( next > period )
+    {
+        blocking = ( task->wcet > blocking ) ? task->wcet : blocking;       // Later jobs may be pushed back too
+    }
+
+    return ( Sched_windowOf( scheduler, extra, task, blocking ) + task->wcet <= Sched_limitOf( task ) );
+}
+
+
+/**
+ * @brief   Analyse function
+ *
+ * Runs the schedulability analysis of the active policy over the registered tasks plus an
+ * extra one. Every task has to keep its total utilization within one and, under FIFO and
+ * the priority policy, its response time within its deadline, under EDF the density plus
+ * the blocking of a longer deadline job has to stay within one for every deadline. Tasks
+ * without a worst case execution time take no time
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   extra[in] Task not registered yet to add to the set, NULL for none
+ * @param   headroom[out] Capacity the analysis leaves unused in parts per million, NULL to not get it
+ *
+ * @retval  1 if the task set is schedulable, 0 otherwise
+ */
+static uint8_t Sched_analyse( Sched_Scheduler *scheduler, Sched_Task *extra, uint32_t *headroom )
+{
+    uint64_t utilization = 0;
+    uint64_t density = 0;
+    uint64_t worst;
+    uint8_t exit;
+
+    for ( uint32_t i = 0; i <= scheduler->tasksCount; i++ )
+    {
+        Sched_Task *task = Sched_memberOf( scheduler, extra, i );
+
+        if ( task != NULL )
+        {
+            utilization += ( ( task->wcet * 1000000u ) + task->period - 1u ) / task->period;      // Rounded up to stay safe
+            density += ( ( task->wcet * 1000000u ) + Sched_limitOf( task ) - 1u ) / Sched_limitOf( task );
+        }
+    }
+
+    worst = ( scheduler->ready.policy == SCHED_POLICY_EDF ) ? density : utilization;
+    exit = ( worst <= 1000000u );
+
+    for ( uint32_t i = 0; ( i <= scheduler->tasksCount ) && exit; i++ )
+    {
+        Sched_Task *task = Sched_memberOf( scheduler, extra, i );
+
+        if ( ( task != NULL ) && ( task->wcet != 0 ) && ( scheduler->ready.policy == SCHED_POLICY_EDF ) )
+        {
+            Sched_Time limit = Sched_limitOf( task );
+            Sched_Time blocking = 0;
+
+            for ( uint32_t j = 0; j <= scheduler->tasksCount; j++ )
+            {
+                Sched_Task *other = Sched_memberOf( scheduler, extra, j );
+
+                if ( ( other != NULL ) && ( Sched_limitOf( other ) > limit ) && ( other->wcet > blocking ) )
+                {
+                    blocking = other->wcet;         // A later deadline job already running
+                }
+            }
+
+            blocking = ( ( blocking * 1000000u ) + limit - 1u ) / limit;
+            worst = ( density + blocking > worst ) ? ( density + blocking ) : worst;
+            exit = ( worst <= 1000000u );
+        }
+        else if ( ( task != NULL ) && ( task->wcet != 0 ) )
+        {
+            exit = Sched_responds( scheduler, extra, task );
+        }
+    }
+
+    if ( headroom != NULL )
+    {
+        *headroom = exit ? (uint32_t)( 1000000u - worst ) : 0u;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Key function
+ *
+ * Gets the ready queue key of a task released on the current tick, its absolute deadline
+ * or its priority
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  The ready queue key
+ */
+static uint32_t Sched_keyOf( Sched_Scheduler *scheduler, Sched_Task *task )
+{
+    Sched_Time deadline = ( ( task->deadline != 0 ) ? task->deadline : task->period ) / scheduler->base;
+    uint32_t key = (uint32_t)scheduler->ticksCount + ( ( deadline < SCHED_TICKS_MAX ) ? (uint32_t)deadline : SCHED_TICKS_MAX );     // Ticks compared relative to the current one
+
+    if ( scheduler->ready.policy == SCHED_POLICY_PRIORITY )
+    {
+        key = task->priority;
+    }
+
+    return key;
+}
+
+
+/**
+ * @brief   Notify function
+ *
+ * Queue listener of the event tasks, it can be called from any thread. The task goes on the
+ * event list once until the scheduler takes it and the scheduler is woken up
+ *
+ * @param   listener[in] Pointer to the task
+ *
+ * @retval  None
+ */
+static void Sched_notify( void *listener )
+{
+    Sched_Task *task = listener;
+    Sched_Scheduler *scheduler = task->scheduler;
+
+    if ( atomic_exchange( &task->triggered, 1 ) == 0 )
+    {
+        Sched_Task *head = atomic_load( &scheduler->events );
+
+        do
+        {
+            task->nextEvent = head;
+        } while ( atomic_compare_exchange_weak( &scheduler->events, &head, task ) == 0 );
+
+        Sched_wake( scheduler );
+    }
+}
+
+
+/**
+ * @brief   Release now function
+ *
+ * Queues on the ready queue a task released by its queue or by the tasks it depends on,
+ * unless it is stopped or its previous release did not run yet. An activation of a task
+ * depending on others dropped that way is recorded as skipped, a stopped task just drops it
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  None
+ */
+static void Sched_releaseNow( Sched_Scheduler *scheduler, Sched_Task *task )
+{
+    Sched_stopOverrun( task );
+
+    if ( task->startFlag && ( task->pending == 0 ) )
+    {
+        task->releaseTime = Sched_now( scheduler );
+        task->activated = atomic_exchange( &task->activation, UINT64_MAX );
+        task->pending = 1;
+        Ready_push( &scheduler->ready, &task->readyNode, Sched_keyOf( scheduler, task ) );
+    }
+    else if ( task->depends != 0 )
+    {
+        atomic_store( &task->activation, UINT64_MAX );     // The dropped activation does not reach the next one
+
+        if ( task->startFlag && ( task->stats != NULL ) )
+        {
+            Stats_addSkipped( task->stats );           // Stopped tasks just drop it
+        }
+    }
+}
+
+
+/**
+ * @brief   Release events function
+ *
+ * Queues on the ready queue the tasks whose queue was written, in the order of the writes,
+ * and the tasks whose last dependency finished on the worker pool.
+ * On a tick the event tasks that found their job busy on the worker pool are retried first.
+ * The coroutines waiting for a written queue are resumed
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   tick[in] 1 when called on a tick, 0 when woken up between ticks
+ *
+ * @retval  None
+ */
+static void Sched_releaseEvents( Sched_Scheduler *scheduler, uint8_t tick )
+{
+    Sched_Task *task = atomic_exchange( &scheduler->events, NULL );
+    Sched_Task *list = NULL;
+
+    while ( task != NULL )
+    {
+        Sched_Task *next = task->nextEvent;
+
+        task->nextEvent = list;                         // Reverse it, oldest write first
+        list = task;
+        task = next;
+    }
+
+    if ( tick )
+    {
+        while ( scheduler->retry != NULL )
+        {
+            task = scheduler->retry;
+            scheduler->retry = task->nextEvent;
+            task->nextEvent = list;
+            list = task;
+        }
+    }
+
+    for ( Sched_Coro *coro = atomic_exchange( &scheduler->coroEvents, NULL ); coro != NULL; )
+    {
+        Sched_Coro *next = coro->nextEvent;
+
+        atomic_store( &coro->triggered, 0 );
+
+        if ( coro->used && ( coro->wait == SCHED_WAIT_QUEUE ) )
+        {
+            Sched_resumeCoro( scheduler, coro );        // Writes while it does something else are ignored
+        }
+
+        coro = next;
+    }
+
+    while ( list != NULL )
+    {
+        task = list;
+        list = task->nextEvent;
+        atomic_store( &task->triggered, 0 );            // Writes from now on release it again
+
+        if ( task->used == 0 )
+        {
+            Sched_dropTask( scheduler, task );
+        }
+        else if ( ( task->queue != NULL ) || ( task->depends != 0 ) )
+        {
+            Sched_releaseNow( scheduler, task );
+        }
+    }
+}
+
+
+/**
+ * @brief   Finish task function
+ *
+ * Records the latency of the activation a run belongs to and releases the tasks depending on
+ * it once all their other dependencies finished in the same activation. A task finishing
+ * again in the same activation does not count again. The activation of a
+ * task released by its period or its queue starts on that release, a dependent task takes
+ * the earliest activation of the tasks it depends on. On the scheduler thread the tasks are
+ * queued right away and run in the same dispatch, from the worker pool they go through the
+ * event list
+ *
+ * @param   task[in] Pointer to the task that finished
+ *
+ * @retval  None
+ */
+static void Sched_finishTask( Sched_Task *task )
+{
+    Sched_Scheduler *scheduler = task->scheduler;
+    uint64_t origin = task->runOrigin;
+
+    if ( task->pathStats != NULL )
+    {
+        uint64_t end = Sched_now( scheduler );
+
+        Stats_addRun( task->pathStats, origin, origin, ( end > origin ) ? end : origin, task->period * SCHED_NS_PER_US );
+    }
+
+    for ( uint8_t i = 0; i < task->successors; i++ )
+    {
+        Sched_Task *next = task->successor[ i ];
+        uint32_t bit = task->successorBit[ i ];
+        uint64_t earliest = atomic_load( &next->activation );
+        uint32_t done = atomic_load( &next->finished );
+        uint32_t update;
+
+        while ( ( origin < earliest ) && ( atomic_compare_exchange_weak( &next->activation, &earliest, origin ) == 0 ) )
+        {
+            // Another worker moved it, check again
+        }
+
+        do
+        {
+            update = ( ( done | bit ) == next->dependMask ) ? 0u : ( done | bit );     // The last one starts the next activation
+        } while ( atomic_compare_exchange_weak( &next->finished, &done, update ) == 0 );
+
+        if ( ( ( done & bit ) == 0u ) && ( update == 0u ) )          // Last dependency of the activation, each counted once
+        {
+            if ( scheduler->pool == NULL )
+            {
+                Sched_releaseNow( scheduler, next );
+            }
+            else
+            {
+                Sched_notify( next );
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief   Run job function
+ *
+ * Runs the task of a worker pool job on the worker thread, the worker records its events on
+ * its own ring, then releases the tasks that depend on it
+ *
+ * @param   job[in] Pointer to the job of the task
+ *
+ * @retval  None
+ */
+static void Sched_runJob( Pool_Job *job )
+{
+    Sched_Task *task = SCHED_TASK_OF_JOB( job );
+
+    if ( ( Trace_currentRing == NULL ) && ( task->scheduler->workerTrace != NULL ) )
+    {
+        Trace_bindRing( &task->scheduler->workerTrace[ Pool_currentWorker() ] );      // First job on this worker
+    }
+
+    Sched_runTask( task );
+    Sched_finishTask( task );
+}
+
+
+/**
+ * @brief   Reaches function
+ *
+ * Tells if a task is reached following the dependencies from another one, every task is
+ * searched once using the visit marks
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   from[in] Task to start from
+ * @param   to[in] Task to look for
+ *
+ * @retval  1 if the task is reached, 0 otherwise
+ */
+static uint8_t Sched_reaches( Sched_Scheduler *scheduler, Sched_Task *from, Sched_Task *to )
+{
+    uint8_t exit = ( from == to );
+
+    from->visit = scheduler->visits;
+
+    for ( uint8_t i = 0; ( i < from->successors ) && ( exit == 0 ); i++ )
+    {
+        if ( from->successor[ i ]->visit != scheduler->visits )
+        {
+            exit = Sched_reaches( scheduler, from->successor[ i ], to );
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Unlink task function
+ *
+ * Removes the dependencies from and to a task. The tasks that depended on it start their
+ * activation over, or go back to their period if it was their last dependency
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  None
+ */
+static void Sched_unlinkTask( Sched_Scheduler *scheduler, Sched_Task *task )
+{
+    for ( uint8_t i = 0; i < task->successors; i++ )
+    {
+        Sched_Task *next = task->successor[ i ];
+
+        next->depends--;
+        next->dependMask &= ~task->successorBit[ i ];
+        atomic_store( &next->finished, 0 );
+
+        if ( next->depends == 0 )
+        {
+            Sched_alignTask( scheduler, next );         // Back on its slots
+        }
+    }
+
+    task->successors = 0;
+
+    for ( uint32_t i = 0; ( i < scheduler->tasksCount ) && ( task->depends != 0 ); i++ )
+    {
+        Sched_Task *other = scheduler->taskPtr + i;
+
+        for ( uint8_t j = 0; j < other->successors; j++ )
+        {
+            if ( other->successor[ j ] == task )
+            {
+                other->successors--;
+                other->successor[ j ] = other->successor[ other->successors ];     // Order of the others does not matter
+                other->successorBit[ j ] = other->successorBit[ other->successors ];
+                task->depends--;
+            }
+        }
+    }
+
+    task->dependMask = 0;
+    atomic_store( &task->finished, 0 );
+}
+
+
+/**
+ * @brief   Release task function
+ *
+ * Releases a task on its next slot, start + k * period, and queues it on the ready queue with
+ * its absolute deadline or its priority. When the scheduler was late and more slots went by,
+ * the catch-up policy of the task decides how many of them run, the task always resyncs to
+ * its slots. A task still waiting from a previous release keeps its place
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the due task
+ * @param   missed[in] Slots that went by after the next one
+ *
+ * @retval  None
+ */
+static void Sched_releaseTask( Sched_Scheduler *scheduler, Sched_Task *task, uint32_t missed )
+{
+    uint32_t key = Sched_keyOf( scheduler, task );
+    Sched_Time slot = task->absLastTime + task->period;
+    uint32_t runs = 1;
+    uint32_t dropped = missed;
+
+    if ( task->catchup == SCHED_CATCHUP_BURST )
+    {
+        runs = missed + 1u;                             // Run every slot, oldest first
+        dropped = 0;
+    }
+    else if ( ( task->catchup == SCHED_CATCHUP_SKIP ) && ( missed != 0 ) )
+    {
+        runs = 0;                                       // Wait for the next slot
+        dropped = missed + 1u;
+    }
+    else
+    {
+        slot += missed * task->period;                  // Run once for the latest slot
+    }
+
+    task->absLastTime += ( missed + 1u ) * task->period;
+
+    if ( ( task->pending != 0 ) && ( task->catchup != SCHED_CATCHUP_BURST ) )
+    {
+        dropped += runs;                                // Previous release did not run yet
+        runs = 0;
+    }
+
+    if ( runs != 0 )
+    {
+        if ( task->pending == 0 )
+        {
+            task->releaseTime = scheduler->epoch + ( slot * SCHED_NS_PER_US );
+            Ready_push( &scheduler->ready, &task->readyNode, key );
+        }
+
+        task->pending += runs;
+    }
+
+    for ( ; ( dropped != 0 ) && ( task->stats != NULL ); dropped-- )
+    {
+        Stats_addSkipped( task->stats );
+    }
+}
+
+
+/**
+ * @brief   Due task function
+ *
+ * Releases a periodic task if its next slot came, with the slots that went by after it
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task
+ * @param   now[in] Scheduler time in us of the current tick
+ *
+ * @retval  None
+ */
+static void Sched_dueTask( Sched_Scheduler *scheduler, Sched_Task *task, Sched_Time now )
+{
+    Sched_Time slot = task->absLastTime + task->period;
+
+    Sched_stopOverrun( task );
+
+    if ( Sched_isPeriodic( task ) && task->startFlag && ( now >= slot ) )      // Run task only if starFlag is True and its slot came
+    {
+        Sched_releaseTask( scheduler, task, (uint32_t)( ( now - slot ) / task->period ) );    // Queue it to run
+    }
+}
+
+
+/**
+ * @brief   GCD function
+ *
+ * Gets the greatest common divisor of two numbers
+ *
+ * @param   a[in] First number
+ * @param   b[in] Second number
+ *
+ * @retval  The greatest common divisor, the other number if one of them is 0
+ */
+static uint64_t Sched_gcd( uint64_t a, uint64_t b )
+{
+    while ( b != 0 )
+    {
+        uint64_t rest = a % b;
+
+        a = b;
+        b = rest;
+    }
+
+    return a;
+}
+
+
+/**
+ * @brief   Phase of function
+ *
+ * Gets the tick within its period a periodic task is released on
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task
+ *
+ * @retval  The phase in ticks, from 0 to the period in ticks - 1
+ */
+static uint64_t Sched_phaseOf( Sched_Scheduler *scheduler, Sched_Task *task )
+{
+    return ( task->absLastTime / scheduler->base ) % ( task->period / scheduler->base );
+}
+
+
+/**
+ * @brief   Load frames function
+ *
+ * Adds the weight of a task to the load of every frame it is released on, the loads are kept
+ * on the frame offsets while the phases are chosen
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task
+ * @param   frames[in] Minor frames of the table being built
+ * @param   minor[in] Ticks of a minor frame
+ *
+ * @retval  None
+ */
+static void Sched_loadFrames( Sched_Scheduler *scheduler, Sched_Task *task, uint64_t frames, uint64_t minor )
+{
+    uint32_t *load = scheduler->cyclicPtr;
+    uint32_t weight = ( task->wcet == 0 ) ? 1u : ( ( task->wcet < UINT32_MAX ) ? (uint32_t)task->wcet : UINT32_MAX );
+    uint64_t step = ( task->period / scheduler->base ) / minor;
+
+    for ( uint64_t f = Sched_phaseOf( scheduler, task ) / minor; f < frames; f += step )
+    {
+        load[ f ] = ( load[ f ] > UINT32_MAX - weight ) ? UINT32_MAX : ( load[ f ] + weight );
+    }
+}
+
+
+/**
+ * @brief   Place task function
+ *
+ * Gives a task the phase whose busiest frame is the least loaded one, the earliest phase on
+ * a tie, and moves its slots to that phase. The first release is the first slot of the phase
+ * one period or more after the current tick, as a task released without a phase
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   task[in] Pointer to the task
+ * @param   frames[in] Minor frames of the table being built
+ * @param   minor[in] Ticks of a minor frame
+ *
+ * @retval  None
+ */
+static void Sched_placeTask( Sched_Scheduler *scheduler, Sched_Task *task, uint64_t frames, uint64_t minor )
+{
+    uint32_t *load = scheduler->cyclicPtr;
+    uint64_t period = task->period / scheduler->base;
+    uint64_t first = scheduler->ticksCount + period;
+    uint32_t best = UINT32_MAX;
+    uint64_t phase = 0;
+
+    for ( uint64_t candidate = 0; candidate < period; candidate += minor )
+    {
+        uint32_t busiest = 0;
+
+        for ( uint64_t f = candidate / minor; f < frames; f += period / minor )
+        {
+            busiest = ( load[ f ] > busiest ) ? load[ f ] : busiest;
+        }
+
+        if ( busiest < best )
+        {
+            best = busiest;
+            phase = candidate;
+        }
+    }
+
+    first += ( phase + period - ( first % period ) ) % period;           // First slot of the phase a period or more ahead
+
+    task->absLastTime = ( first - period ) * scheduler->base;
+    task->phased = 1;
+}
+
+
+/**
+ * @brief   Build frames function
+ *
+ * Builds the frame table of the cyclic mode. The minor frame is the gcd of the periods and
+ * phases of the periodic tasks and the major frame, the hyperperiod, the lcm of the periods.
+ * The phased tasks keep their slots and the new ones are placed on the least loaded frames,
+ * every task weighs its WCET or 1 if it has none. The buffer holds frames + 1 offsets followed
+ * by the task slots of every frame in registration order. If the table does not fit the
+ * buffer or the hyperperiod is longer than SCHED_TICKS_MAX ticks, every task is checked on
+ * every tick as without the cyclic mode
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_buildFrames( Sched_Scheduler *scheduler )
+{
+    uint32_t *offsets = scheduler->cyclicPtr;
+    uint64_t minor = 0;
+    uint64_t major = 1;
+    uint64_t entries = 0;
+    uint64_t frames = 0;
+
+    scheduler->cyclicDirty = 0;
+    scheduler->cyclicFrames = 0;
+    scheduler->cyclicTick = scheduler->ticksCount;
+
+    for ( uint32_t i = 0; ( i < scheduler->tasksCount ) && ( major <= SCHED_TICKS_MAX ); i++ )
+    {
+        Sched_Task *task = scheduler->taskPtr + i;
+        uint64_t period = task->period / scheduler->base;
+
+        if ( Sched_isPeriodic( task ) )
+        {
+            minor = Sched_gcd( Sched_gcd( minor, period ), task->phased ? Sched_phaseOf( scheduler, task ) : 0u );
+            major = ( major / Sched_gcd( major, period ) ) * period;
+        }
+    }
+
+    for ( uint32_t i = 0; ( i < scheduler->tasksCount ) && ( major <= SCHED_TICKS_MAX ); i++ )
+    {
+        Sched_Task *task = scheduler->taskPtr + i;
+
+        if ( Sched_isPeriodic( task ) )
+        {
+            entries += major / ( task->period / scheduler->base );
+        }
+    }
+
+    if ( ( minor != 0 ) && ( major <= SCHED_TICKS_MAX ) )
+    {
+        frames = major / minor;
+    }
+
+    if ( ( frames != 0 ) && ( offsets != NULL ) && ( frames + 1u + entries <= scheduler->cyclicSize ) )
+    {
+        uint32_t *slots = offsets + frames + 1u;
+
+        for ( uint64_t f = 0; f <= frames; f++ )
+        {
+            offsets[ f ] = 0;
+        }
+
+        for ( uint32_t i = 0; i < scheduler->tasksCount; i++ )     // Load of the tasks that keep their slots
+        {
+            Sched_Task *task = scheduler->taskPtr + i;
+
+            if ( Sched_isPeriodic( task ) && task->phased )
+            {
+                Sched_loadFrames( scheduler, task, frames, minor );
+            }
+        }
+
+        for ( uint32_t i = 0; i < scheduler->tasksCount; i++ )     // New tasks on the least loaded frames
+        {
+            Sched_Task *task = scheduler->taskPtr + i;
+
+            if ( Sched_isPeriodic( task ) && ( task->phased == 0 ) )
+            {
+                Sched_placeTask( scheduler, task, frames, minor );
+                Sched_loadFrames( scheduler, task, frames, minor );
+            }
+        }
+
+        for ( uint64_t f = 0; f <= frames; f++ )
+        {
+            offsets[ f ] = 0;
+        }
+
+        for ( uint8_t fill = 0; fill < 2; fill++ )      // Count the tasks of every frame, then write them down
+        {
+            for ( uint32_t i = 0; i < scheduler->tasksCount; i++ )
+            {
+                Sched_Task *task = scheduler->taskPtr + i;
+                uint64_t step = ( task->period / scheduler->base ) / minor;
+
+                for ( uint64_t f = Sched_phaseOf( scheduler, task ) / minor; Sched_isPeriodic( task ) && ( f < frames ); f += step )
+                {
+                    if ( fill )
+                    {
+                        slots[ offsets[ f ]++ ] = i;    // The offset moves on to the next free entry
+                    }
+                    else
+                    {
+                        offsets[ f + 1u ]++;
+                    }
+                }
+            }
+
+            for ( uint64_t f = 0; ( fill == 0 ) && ( f < frames ); f++ )
+            {
+                offsets[ f + 1u ] += offsets[ f ];      // First entry of every frame
+            }
+        }
+
+        for ( uint64_t f = frames; f > 0; f-- )
+        {
+            offsets[ f ] = offsets[ f - 1u ];           // Back to the first entry of every frame
+        }
+
+        offsets[ 0 ] = 0;
+        scheduler->minorTicks = (uint32_t)minor;
+        scheduler->cyclicFrames = (uint32_t)frames;
+    }
+}
+
+
+/**
+ * @brief   Release due function
+ *
+ * Releases the periodic tasks whose slot came. In cyclic mode only the tasks of the frames
+ * since the last lookup are checked, once the table is built again if the task set changed,
+ * otherwise every task is checked
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_releaseDue( Sched_Scheduler *scheduler )
+{
+    Sched_Time now = scheduler->ticksCount * scheduler->base;
+
+    if ( scheduler->cyclic && scheduler->cyclicDirty )
+    {
+        Sched_buildFrames( scheduler );
+    }
+
+    if ( scheduler->cyclic && ( scheduler->cyclicFrames != 0 ) )
+    {
+        uint64_t minor = scheduler->minorTicks;
+        uint64_t tick = ( ( scheduler->cyclicTick + minor - 1u ) / minor ) * minor;     // First frame not looked up yet
+        uint32_t *slots = scheduler->cyclicPtr + scheduler->cyclicFrames + 1u;
+
+        for ( uint32_t n = 0; ( tick <= scheduler->ticksCount ) && ( n < scheduler->cyclicFrames ); n++ )      // Every frame once at most
+        {
+            uint32_t f = (uint32_t)( ( tick / minor ) % scheduler->cyclicFrames );
+
+            for ( uint32_t e = scheduler->cyclicPtr[ f ]; e < scheduler->cyclicPtr[ f + 1u ]; e++ )
+            {
+                Sched_dueTask( scheduler, scheduler->taskPtr + slots[ e ], now );
+            }
+
+            tick += minor;
+        }
+
+        scheduler->cyclicTick = scheduler->ticksCount + 1u;
+    }
+    else
+    {
+        for ( uint32_t i = 0; i < scheduler->tasksCount; i++ )
+        {
+            Sched_dueTask( scheduler, scheduler->taskPtr + i, now );
+        }
+    }
+}
+
+
+/**
+ * @brief   Dispatch function
+ *
+ * Runs the tasks of the ready queue in the order of the scheduler policy. Except for the FIFO
+ * policy, dispatching stops once the tick is over and the remaining tasks wait for the next
+ * tick, where newly released tasks with an earlier deadline can go before them. With a worker
+ * pool the tasks are submitted to it in the same order, a task still running from its
+ * previous release is skipped so it never overlaps with itself. A task bursting through
+ * missed slots is queued again after every run until all of them ran, on the worker pool a
+ * burst runs once and an event task still running is retried on the next tick. The tasks
+ * depending on a task run on the scheduler thread are released once it returns. Tasks
+ * unregistered while waiting go to the free list here
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_dispatch( Sched_Scheduler *scheduler )
+{
+    Ready_Node *node;
+
+    while ( ( node = Ready_pop( &scheduler->ready ) ) != NULL )
+    {
+        Sched_Task *actual_task = SCHED_TASK_OF( node );
+        uint16_t generation = actual_task->generation;
+
+        Sched_stopOverrun( actual_task );               // Its last run on the worker pool could be over budget
+
+        if ( actual_task->used == 0 )               // Task could be unregistered while waiting
+        {
+            actual_task->pending = 0;
+            Sched_dropTask( scheduler, actual_task );
+        }
+        else if ( actual_task->startFlag == 0 )         // Task could be stopped while waiting
+        {
+            actual_task->pending = 0;
+        }
+        else if ( scheduler->pool != NULL )
+        {
+            if ( atomic_load( &actual_task->job.busy ) == 0 )
+            {
+                Sched_snapTask( actual_task );          // Its previous run is over, nothing reads them
+            }
+
+            if ( Pool_submit( scheduler->pool, &actual_task->job ) )
+            {
+                // Queued on the pool
+            }
+            else if ( ( actual_task->queue != NULL ) && ( atomic_exchange( &actual_task->triggered, 1 ) == 0 ) )
+            {
+                actual_task->nextEvent = scheduler->retry;          // Its queue has data the running job may miss
+                scheduler->retry = actual_task;
+            }
+            else if ( actual_task->stats != NULL )
+            {
+                Stats_addSkipped( actual_task->stats );             // Still running from its previous release
+            }
+
+            actual_task->pending = 0;
+        }
+        else
+        {
+            actual_task->elapsed = ( scheduler->ticksCount * scheduler->base ) - actual_task->absLastTime;
+            Sched_snapTask( actual_task );
+            Sched_runTask( actual_task );                           // Run function
+
+            if ( actual_task->generation == generation )
+            {
+                Sched_stopOverrun( actual_task );
+                Sched_finishTask( actual_task );                    // Tasks depending on it run in this dispatch
+            }
+
+            if ( actual_task->generation != generation )
+            {
+                // Unregistered by its own run, the slot is already free
+            }
+            else if ( ( --actual_task->pending != 0 ) && actual_task->startFlag )
+            {
+                actual_task->releaseTime += actual_task->period * SCHED_NS_PER_US;     // Next slot of the burst
+                Ready_push( &scheduler->ready, node, node->key );
+            }
+            else
+            {
+                actual_task->pending = 0;
+            }
+        }
+
+        if ( ( scheduler->ready.policy != SCHED_POLICY_FIFO ) && ( scheduler->pool == NULL ) && ( Sched_now( scheduler ) >= Sched_tickTime( scheduler, scheduler->ticksCount + 1u ) ) )
+        {
+            break;          // Tick is over
+        }
+    }
+}
+
+
+#ifdef __linux__
+/**
+ * @brief   Prefault function
+ *
+ * Writes every page of a buffer back with its own value, so the pages are mapped before the
+ * scheduler needs them
+ *
+ * @param   buffer[in] Pointer to the buffer, NULL for none
+ * @param   size[in] Bytes of the buffer
+ *
+ * @retval  None
+ */
+static void Sched_prefault( void *buffer, size_t size )
+{
+    volatile uint8_t *byte = buffer;
+    size_t page = (size_t)sysconf( _SC_PAGESIZE );
+
+    for ( size_t i = 0; ( byte != NULL ) && ( i < size ); i += page )
+    {
+        byte[ i ] = byte[ i ];
+    }
+
+    if ( ( byte != NULL ) && ( size != 0 ) )
+    {
+        byte[ size - 1u ] = byte[ size - 1u ];
+    }
+}
+
+
+/**
+ * @brief   Prefault stack function
+ *
+ * Touches SCHED_RT_STACK bytes of the stack below the caller
+ *
+ * @retval  None
+ */
+static void __attribute__(( noinline )) Sched_prefaultStack( void )
+{
+    volatile uint8_t stack[ SCHED_RT_STACK ];
+
+    Sched_prefault( (void *)stack, sizeof( stack ) );
+}
+
+
+/**
+ * @brief   Enter real-time function
+ *
+ * Pins the calling thread to the scheduler CPU, locks the memory, prefaults the stack and the
+ * scheduler buffers and switches the thread to SCHED_FIFO. Every step that is not permitted
+ * is skipped and the thread keeps running as it was
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   saved[out] Scheduling of the thread to restore with Sched_leaveRealtime
+ *
+ * @retval  The steps that worked, SCHED_RT_FIFO, SCHED_RT_LOCKED and SCHED_RT_PINNED bits
+ */
+static uint8_t Sched_enterRealtime( Sched_Scheduler *scheduler, Sched_Saved *saved )
+{
+    pthread_t self = pthread_self();
+    struct sched_param param;
+    int min = sched_get_priority_min( SCHED_FIFO );
+    int max = sched_get_priority_max( SCHED_FIFO );
+    uint8_t exit = 0;
+
+    pthread_getschedparam( self, &saved->policy, &saved->param );
+    pthread_getaffinity_np( self, sizeof( saved->cpus ), &saved->cpus );
+
+    if ( scheduler->cpu >= 0 )
+    {
+        cpu_set_t cpus;
+
+        CPU_ZERO( &cpus );
+        CPU_SET( scheduler->cpu, &cpus );
+
+        if ( pthread_setaffinity_np( self, sizeof( cpus ), &cpus ) == 0 )
+        {
+            exit |= SCHED_RT_PINNED;
+        }
+    }
+
+    if ( mlockall( MCL_CURRENT | MCL_FUTURE ) == 0 )
+    {
+        exit |= SCHED_RT_LOCKED;
+    }
+
+    Sched_prefaultStack();
+    Sched_prefault( scheduler->taskPtr, scheduler->tasks * sizeof( Sched_Task ) );
+    Sched_prefault( scheduler->timerPtr, scheduler->timers * sizeof( Sched_Timer ) );
+    Sched_prefault( scheduler->coroPtr, scheduler->coros * sizeof( Sched_Coro ) );
+    Sched_prefault( scheduler->frameArena, scheduler->coros * scheduler->frameSize );
+    Sched_prefault( scheduler->sourcePtr, scheduler->sources * sizeof( Sched_Source ) );
+
+    for ( uint32_t i = 0; i < scheduler->tasksCount; i++ )
+    {
+        Que_Queue *queue = scheduler->taskPtr[ i ].queue;
+
+        if ( scheduler->taskPtr[ i ].used && ( queue != NULL ) )
+        {
+            Sched_prefault( queue->Buffer, queue->Elements * queue->Size );
+        }
+    }
+
+    param.sched_priority = min + scheduler->rtPriority;
+    param.sched_priority = ( param.sched_priority < max ) ? param.sched_priority : max;
+
+    if ( pthread_setschedparam( self, SCHED_FIFO, &param ) == 0 )
+    {
+        exit |= SCHED_RT_FIFO;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Leave real-time function
+ *
+ * Undoes the steps Sched_enterRealtime could do
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   saved[in] Scheduling of the thread before the real-time mode
+ *
+ * @retval  None
+ */
+static void Sched_leaveRealtime( Sched_Scheduler *scheduler, Sched_Saved *saved )
+{
+    pthread_t self = pthread_self();
+
+    if ( scheduler->rtStatus & SCHED_RT_FIFO )
+    {
+        pthread_setschedparam( self, saved->policy, &saved->param );
+    }
+
+    if ( scheduler->rtStatus & SCHED_RT_LOCKED )
+    {
+        munlockall();
+    }
+
+    if ( scheduler->rtStatus & SCHED_RT_PINNED )
+    {
+        pthread_setaffinity_np( self, sizeof( saved->cpus ), &saved->cpus );
+    }
+}
+#endif
+
+
+/**
+ * @brief   Check pins function
+ *
+ * Unpins the tasks pinned to a worker the pool does not have, the pool can be attached after
+ * they were pinned
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_checkPins( Sched_Scheduler *scheduler )
+{
+    for ( uint32_t i = 0; i < scheduler->tasksCount; i++ )
+    {
+        Sched_Task *task = &scheduler->taskPtr[ i ];
+
+        if ( task->used && ( task->job.worker != POOL_ANY_WORKER ) && ( task->job.worker >= scheduler->pool->workers ) )
+        {
+            task->job.worker = POOL_ANY_WORKER;
+        }
+    }
+}
+
+
+/**
+ * @brief   Run function
+ *
+ * Runs the scheduler loop from the current tick up to the given one, see
+ * Sched_startScheduler
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param   last[in] Last tick to run
+ *
+ * @retval  None
+ */
+static void Sched_run( Sched_Scheduler *scheduler, uint64_t last )
+{
+    uint64_t tickTime = (uint64_t)scheduler->base * SCHED_NS_PER_US;
+    uint8_t jump = scheduler->tickless || scheduler->simulated;      // Skip the ticks without work
+    uint8_t watching = 0;
+    Trace_Ring *ring = Trace_currentRing;
+#ifdef __linux__
+    Sched_Saved saved;
+#endif
+
+    if ( scheduler->trace != NULL )
+    {
+        Trace_bindRing( scheduler->trace );             // Record the events of this thread
+    }
+
+    if ( scheduler->pool != NULL )
+    {
+        Sched_checkPins( scheduler );
+    }
+
+#ifdef __linux__
+    if ( ( scheduler->sources != 0 ) && ( scheduler->simulated == 0 ) )
+    {
+        Sched_openPoll( scheduler );                    // Ticks and fds share one epoll wait
+    }
+
+    scheduler->rtStatus = 0;
+
+    if ( scheduler->realtime && ( scheduler->simulated == 0 ) )
+    {
+        scheduler->rtStatus = Sched_enterRealtime( scheduler, &saved );
+    }
+#endif
+
+    scheduler->epoch = Sched_now( scheduler ) - ( scheduler->ticksCount * tickTime );
+    scheduler->load.mark = scheduler->epoch + ( scheduler->ticksCount * tickTime );     // Time between runs is not accounted
+    scheduler->watchdogStop = 0;
+
+    if ( Sched_watchdogOf( scheduler ) != 0 )
+    {
+        watching = ( pthread_create( &scheduler->watchdogThread, NULL, Sched_watchdogThread, scheduler ) == 0 );   // Without it the budgets are still checked once the tasks finish
+    }
+
+    while ( 1 )
+    {
+        uint64_t next;
+        uint64_t current;
+        uint64_t started;
+
+        TRACE_EVENT( TRACE_TICK_BEGIN, scheduler->ticksCount );
+        scheduler->wakeups++;
+
+        // Static task table
+        if ( scheduler->table != NULL )
+        {
+            scheduler->table->dispatchPtr( scheduler->tableTick, scheduler->ticksCount );     // Direct calls to every due task
+            scheduler->tableTick = scheduler->ticksCount;
+        }
+
+        // Tasks
+        Sched_releaseDue( scheduler );
+
+
+        Sched_releaseEvents( scheduler, 1 );
+        Sched_dispatch( scheduler );
+
+
+        // Timers
+        Sched_expireTimers( scheduler, (uint32_t)scheduler->ticksCount );
+
+
+        // Coroutines
+        Sched_expireSleeps( scheduler, (uint32_t)scheduler->ticksCount );
+        Sched_resumeCoros( scheduler );
+
+        TRACE_EVENT( TRACE_TICK_END, scheduler->ticksCount );
+
+
+        if (scheduler->ticksCount >= last)
+        {
+            break;          // Finish the scheduler
+        }
+
+        next = scheduler->ticksCount + ( jump ? Sched_nextDeadline( scheduler, last ) : 1u );
+
+        while ( Sched_idleUntil( scheduler, Sched_tickTime( scheduler, next ) ) )      // Wait for the tick or until something is due
+        {
+            Sched_releaseEvents( scheduler, 0 );        // Queues written, run their tasks now
+            Sched_dispatch( scheduler );
+            Sched_resumeCoros( scheduler );
+
+            if ( jump )
+            {
+                next = scheduler->ticksCount + Sched_nextDeadline( scheduler, last );
+            }
+        }
+
+        started = Sched_now( scheduler );
+        current = ( started - scheduler->epoch ) / tickTime;
+
+        if ( ( scheduler->simulated == 0 ) && ( started > Sched_tickTime( scheduler, next ) + scheduler->maxJitter ) )
+        {
+            scheduler->maxJitter = started - Sched_tickTime( scheduler, next );     // Worst delay of a tick start so far
+        }
+
+        if ( current > next )
+        {
+            next = ( current < last ) ? current : last;        // Late, jump to the current tick
+        }
+
+        scheduler->ticksCount = next;
+        
+    }
+
+#ifdef __linux__
+    Sched_closePoll( scheduler );
+#endif
+
+    if ( scheduler->pool != NULL )
+    {
+        Pool_wait( scheduler->pool );       // Wait for the tasks still running
+    }
+
+    if ( watching )
+    {
+        pthread_mutex_lock( &scheduler->lock );
+        scheduler->watchdogStop = 1;
+        pthread_cond_signal( &scheduler->watchdogWake );
+        pthread_mutex_unlock( &scheduler->lock );
+        pthread_join( scheduler->watchdogThread, NULL );
+    }
+
+#ifdef __linux__
+    Sched_leaveRealtime( scheduler, &saved );
+#endif
+
+    Trace_bindRing( ring );
+}
+
+
+/**
+ * @brief   Unlisten all function
+ *
+ * Takes the tasks and coroutines of the scheduler out of the queues they listen to, so the
+ * queues do not call into slots that are about to be reused
+ *
+ * @param   scheduler[in] Pointer to a Sched_Scheduler variable
+ *
+ * @retval  None
+ */
+static void Sched_unlistenAll( Sched_Scheduler *scheduler )
+{
+    for ( uint32_t i = 0; i < scheduler->corosCount; i++ )
+    {
+        Sched_Coro *coro = &scheduler->coroPtr[ i ];
+
+        if ( coro->used && ( coro->queue != NULL ) )
+        {
+            Sched_unlistenQueue( coro->queue, coro, coro->prevNotify, coro->prevListener );
+            coro->queue = NULL;
+        }
+    }
+
+    for ( uint32_t i = 0; i < scheduler->tasksCount; i++ )
+    {
+        Sched_Task *task = &scheduler->taskPtr[ i ];
+
+        if ( task->used && ( task->queue != NULL ) )
+        {
+            Sched_unlistenQueue( task->queue, task, NULL, NULL );
+            task->queue = NULL;
+        }
+    }
+}
+
+
+/**
+ * @brief Init Scheduler function
+ * 
+ * This funcitons initializes the scheduler, every task, timer and coroutine is dropped and
+ * the handles start again from 1. The scheduler has to be zeroed before its first init, as a
+ * static variable or with = { 0 }, the lock and the condition variables are set up on the
+ * first init only so it can be initialized again, Sched_deinitScheduler releases them. The
+ * policy and the tick have to be set before, the ready queue is built for the policy and the
+ * tick is taken here, from tickUs or from tick in ms when it is 0. Initialized again, its
+ * tasks and coroutines first stop listening to their queues
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable, this is the scheduler
+ * 
+ * @retval None
+*/
+void Sched_initScheduler( Sched_Scheduler *scheduler )
+{
+    pthread_condattr_t attr;
+
+    if ( scheduler->primed )
+    {
+        Sched_unlistenAll( scheduler );                 // Initialized again
+    }
+
+    scheduler->base = ( scheduler->tickUs != 0 ) ? scheduler->tickUs : SCHED_MS( scheduler->tick );
+    scheduler->tasksCount = 0;
+    scheduler->ticksCount = 0;
+    scheduler->timersCount = 0;
+    scheduler->freeTask = 0;
+    scheduler->freeTimer = 0;
+    scheduler->retry = NULL;
+    scheduler->corosCount = 0;
+    scheduler->freeCoro = NULL;
+    scheduler->resumeHead = NULL;
+    scheduler->resumeTail = NULL;
+    atomic_store( &scheduler->events, NULL );
+    atomic_store( &scheduler->coroEvents, NULL );
+    atomic_store( &scheduler->clock, 0 );
+    scheduler->rtStatus = 0;
+    scheduler->maxJitter = 0;
+    scheduler->wakeups = 0;
+    scheduler->table = NULL;
+    scheduler->tableTick = 0;
+    scheduler->cyclicFrames = 0;
+    scheduler->cyclicDirty = 1;
+    scheduler->cyclicTick = 0;
+    scheduler->visits = 0;
+    atomic_store( &scheduler->tasksWatched, 0 );
+    Stats_initLoad( &scheduler->load, Sched_now( scheduler ) );
+    scheduler->pollFd = -1;
+    scheduler->tickFd = -1;
+    scheduler->wakeFd = -1;
+
+    if ( scheduler->primed == 0 )                      // Initializing them twice is undefined
+    {
+        pthread_condattr_init( &attr );
+        pthread_condattr_setclock( &attr, CLOCK_MONOTONIC );       // Waits use the monotonic deadlines
+        pthread_mutex_init( &scheduler->lock, NULL );
+        pthread_cond_init( &scheduler->wake, &attr );
+        pthread_cond_init( &scheduler->watchdogWake, &attr );
+        pthread_condattr_destroy( &attr );
+        scheduler->primed = 1;
+    }
+
+    Wheel_initWheel( &scheduler->wheel, 0 );
+    Wheel_initWheel( &scheduler->sleeps, 0 );
+    Ready_initQueue( &scheduler->ready, scheduler->policy );
+
+    for ( uint32_t i = 0; i < scheduler->tasks; i++ )
+    {
+        scheduler->taskPtr[ i ].generation = 0;
+        scheduler->taskPtr[ i ].used = 0;
+    }
+
+    for ( uint32_t i = 0; i < scheduler->timers; i++ )
+    {
+        Wheel_initNode( &scheduler->timerPtr[ i ].node );
+        scheduler->timerPtr[ i ].generation = 0;
+        scheduler->timerPtr[ i ].used = 0;
+    }
+
+    for ( uint32_t i = 0; i < scheduler->sources; i++ )
+    {
+        scheduler->sourcePtr[ i ].used = 0;
+    }
+}
+
+
+/**
+ * @brief Deinit Scheduler function
+ * 
+ * This function releases the lock and the condition variables of a scheduler that is not
+ * running, the next Sched_initScheduler sets them up again. Its tasks and coroutines stop
+ * listening to their queues
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable, this is the scheduler
+ * 
+ * @retval None
+*/
+void Sched_deinitScheduler( Sched_Scheduler *scheduler )
+{
+    if ( scheduler->primed )
+    {
+        Sched_unlistenAll( scheduler );
+        pthread_cond_destroy( &scheduler->watchdogWake );
+        pthread_cond_destroy( &scheduler->wake );
+        pthread_mutex_destroy( &scheduler->lock );
+        scheduler->primed = 0;
+    }
+}
+
+
+
+/**
+ * @brief Register task function
+ * 
+ * This function register a task into the scheduler.
+ * The time is in ms, Sched_registerTaskUs takes it in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param initPtr[in] Pointer to a function with no parameters and without return, this is the init function
+ * @param taskPtr[in] Pointer to a function without parameters and without return value. This function will be executed periodically
+ * @param period[in] How often you want the task run in ms, multiple of tick
+ * 
+ * @retval The handle of the task you just registered. 0 in case of error
+*/
+uint32_t Sched_registerTask( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period )
+{
+    return Sched_registerTaskUs( scheduler, initPtr, taskPtr, SCHED_MS( period ) );
+}
+
+
+/**
+ * @brief Register task us function
+ * 
+ * This function register a task into the scheduler
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param initPtr[in] Pointer to a function with no parameters and without return, this is the init function
+ * @param taskPtr[in] Pointer to a function without parameters and without return value. This function will be executed periodically
+ * @param period[in] How often you want the task run in us, multiple of tick
+ * 
+ * @retval The handle of the task you just registered. 0 in case of error
+*/
+uint32_t Sched_registerTaskUs( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), Sched_Time period )
+{
+    return Sched_registerTaskWcetUs( scheduler, initPtr, taskPtr, period, 0 );
+}
+
+
+/**
+ * @brief Register task with WCET function
+ * 
+ * This function register a task that declares its worst case execution time. The task is
+ * added with the lowest priority and its deadline equal to the period, and it is rejected
+ * if the schedulability analysis of the active policy finds a deadline that could be missed.
+ * The period is in ms and the WCET in us, Sched_registerTaskWcetUs takes both in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param initPtr[in] Pointer to a function with no parameters and without return, this is the init function
+ * @param taskPtr[in] Pointer to a function without parameters and without return value. This function will be executed periodically
+ * @param period[in] How often you want the task run in ms, multiple of tick
+ * @param wcet[in] Worst case execution time in us, 0 to skip the analysis
+ * 
+ * @retval The handle of the task you just registered. 0 in case of error or if it does not fit
+*/
+uint32_t Sched_registerTaskWcet( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period, Sched_Time wcet )
+{
+    return Sched_registerTaskWcetUs( scheduler, initPtr, taskPtr, SCHED_MS( period ), wcet );
+}
+
+
+/**
+ * @brief Register task with WCET us function
+ * 
+ * This function register a task that declares its worst case execution time. The task is
+ * added with the lowest priority and its deadline equal to the period, and it is rejected
+ * if the schedulability analysis of the active policy finds a deadline that could be missed
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param initPtr[in] Pointer to a function with no parameters and without return, this is the init function
+ * @param taskPtr[in] Pointer to a function without parameters and without return value. This function will be executed periodically
+ * @param period[in] How often you want the task run in us, multiple of tick
+ * @param wcet[in] Worst case execution time in us, 0 to skip the analysis
+ * 
+ * @retval The handle of the task you just registered. 0 in case of error or if it does not fit
+*/
+uint32_t Sched_registerTaskWcetUs( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), Sched_Time period, Sched_Time wcet )
+{
+    Sched_Task *task = NULL;
+    Sched_Task candidate = { 0 };
+    Sched_Time tick = scheduler->base;
+    uint32_t exit = 0;
+
+    candidate.period = period;
+    candidate.wcet = wcet;
+    candidate.deadline = 0;
+    candidate.priority = READY_LEVELS - 1;
+
+    if ( ( period >= tick ) && ( period % tick == 0 ) && ( ( wcet == 0 ) || Sched_analyse( scheduler, &candidate, NULL ) ) )
+    {
+        task = Sched_allocTask( scheduler );
+    }
+
+    if ( task != NULL )
+    {
+        
+        task->period = period;             // Seting the period
+        task->initFunc = initPtr;
+        task->taskFunc = taskPtr;
+        task->elapsed = 0;                 // Initializing time elapsed as 0
+        task->absLastTime = scheduler->ticksCount * tick;     // Slots start now
+        task->catchup = SCHED_CATCHUP_RESYNC;
+        task->pending = 0;
+        task->startFlag = 1;
+        task->deadline = 0;                // Deadline equal to the period
+        task->priority = READY_LEVELS - 1;  // Lowest priority
+        task->wcet = wcet;
+        atomic_store( &task->budget, 0 );
+        atomic_store( &task->overrunAction, SCHED_OVERRUN_RECORD );
+        atomic_store( &task->overrunPtr, NULL );
+        atomic_store( &task->started, 0 );
+        atomic_store( &task->overran, 0 );
+        task->phased = 0;
+        scheduler->cyclicDirty = 1;        // The frame table needs the new task
+        task->successors = 0;
+        task->depends = 0;
+        task->dependMask = 0;
+        atomic_store( &task->finished, 0 );
+        atomic_store( &task->activation, UINT64_MAX );
+        task->pathStats = NULL;
+        task->visit = scheduler->visits;
+        Ready_initNode( &task->readyNode );
+        Pool_initJob( &task->job, taskPtr );
+        task->job.runPtr = Sched_runJob;
+        task->stats = NULL;
+        task->queue = NULL;
+        task->scheduler = scheduler;
+        atomic_store( &task->triggered, 0 );
+        task->used = 1;
+
+        if ( atomic_load( &scheduler->tasksWatched ) < scheduler->tasksCount )
+        {
+            atomic_store( &scheduler->tasksWatched, scheduler->tasksCount );   // The watchdog checks the new slot from now on
+        }
+
+        task->initFunc();                  // Run init function
+        
+        exit = SCHED_HANDLE( task - scheduler->taskPtr, task->generation );
+    }
+
+    return exit;
+    
+
+
+}
+
+
+/**
+ * @brief Unregister task function
+ * 
+ * This function removes a task from the scheduler, its handle stops being valid and its
+ * slot is reused by the next registrations
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to remove
+ * 
+ * @retval 1 if the task has been removed correctly, or 0 otherwise
+*/
+uint8_t Sched_unregisterTask( Sched_Scheduler *scheduler, uint32_t task )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if ( ( actual_task != NULL ) && actual_task->used )
+    {
+        if ( actual_task->queue != NULL )
+        {
+            Sched_unlistenQueue( actual_task->queue, actual_task, NULL, NULL );
+        }
+
+        actual_task->used = 0;
+        actual_task->startFlag = 0;
+        actual_task->generation = ( actual_task->generation + 1u ) & SCHED_GENERATION_MASK;
+        scheduler->cyclicDirty = 1;
+        Sched_unlinkTask( scheduler, actual_task );    // Tasks depending on it do not wait for it anymore
+
+        Sched_dropTask( scheduler, actual_task );        // Otherwise freed once it leaves the ready queue or the event list
+
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Stop task function
+ * 
+ * This function stops a scheduler's task
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to stop
+ * 
+ * @retval 1 if the task has been stopped correctly, or 0 otherwise
+*/
+uint8_t Sched_stopTask( Sched_Scheduler *scheduler, uint32_t task )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit;
+
+    if( actual_task == NULL )
+    {
+        exit = 0;
+    }
+    else
+    {
+        actual_task->startFlag = 0;
+        exit = 1;
+    }
+    
+
+    return exit;
+
+}
+
+
+/**
+ * @brief Start task function
+ * 
+ * This function starts a secheduler's task
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to start
+ * 
+ * @retval 1 if the task has been started correctly, or 0 otherwise
+*/
+uint8_t Sched_startTask( Sched_Scheduler *scheduler, uint32_t task )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if ( actual_task != NULL )
+    {
+        if ( ( actual_task->startFlag == 0 ) && actual_task->used )
+        {
+            Sched_alignTask( scheduler, actual_task );        // Back on the next slot
+        }
+
+        actual_task->startFlag = 1;
+
+        exit = 1;
+    }
+
+    return exit;
+}
+
+/**
+ * @brief Period task function
+ * 
+ * This function changes a task's period.
+ * The time is in ms, Sched_periodTaskUs takes it in us
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param period[in] Task periodicity in ms
+ * 
+ * @retval 1 if the task has been stopped correctly, or 0 otherwise
+*/
+uint8_t Sched_periodTask( Sched_Scheduler *scheduler, uint32_t task, uint32_t period )
+{
+    return Sched_periodTaskUs( scheduler, task, SCHED_MS( period ) );
+}
+
+
+/**
+ * @brief Period task us function
+ * 
+ * This function changes a task's period
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param period[in] Task periodicity in us
+ * 
+ * @retval 1 if the task has been stopped correctly, or 0 otherwise
+*/
+uint8_t Sched_periodTaskUs( Sched_Scheduler *scheduler, uint32_t task, Sched_Time period )
+{
+   Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+   uint8_t exit = 0;
+
+    if( ( period >= scheduler->base ) && (period % scheduler->base == 0 ) && ( actual_task != NULL ) )     // Period has to be a multiple of tick
+    {
+        Sched_Time previous = actual_task->period;
+
+        actual_task->period = period;
+        exit = ( actual_task->wcet == 0 ) || Sched_analyse( scheduler, NULL, NULL );
+
+        if ( exit == 0 )
+        {
+            actual_task->period = previous;                 // The task set would not fit
+        }
+        else if ( actual_task->used )
+        {
+            Sched_alignTask( scheduler, actual_task );       // Slots of the new period
+            actual_task->phased = 0;
+            scheduler->cyclicDirty = 1;
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Deadline task function
+ * 
+ * This function changes the relative deadline the EDF policy uses for a task.
+ * The time is in ms, Sched_deadlineTaskUs takes it in us
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param deadline[in] Time in ms since the task release it has to run, 0 to use the period
+ * 
+ * @retval 1 if the deadline has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_deadlineTask( Sched_Scheduler *scheduler, uint32_t task, uint32_t deadline )
+{
+    return Sched_deadlineTaskUs( scheduler, task, SCHED_MS( deadline ) );
+}
+
+
+/**
+ * @brief Deadline task us function
+ * 
+ * This function changes the relative deadline the EDF policy uses for a task
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param deadline[in] Time in us since the task release it has to run, 0 to use the period
+ * 
+ * @retval 1 if the deadline has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_deadlineTaskUs( Sched_Scheduler *scheduler, uint32_t task, Sched_Time deadline )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( deadline % scheduler->base == 0 ) && ( actual_task != NULL ) && actual_task->used )          // Deadline has to be a multiple of tick
+    {
+        Sched_Time previous = actual_task->deadline;
+
+        actual_task->deadline = deadline;
+        exit = ( actual_task->wcet == 0 ) || Sched_analyse( scheduler, NULL, NULL );
+
+        if ( exit == 0 )
+        {
+            actual_task->deadline = previous;               // The task set would not fit
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Priority task function
+ * 
+ * This function changes the priority the priority policy uses for a task, due tasks of the
+ * same priority run in the order they were released
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param priority[in] Task priority, from 0 (highest) to READY_LEVELS - 1 (lowest)
+ * 
+ * @retval 1 if the priority has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_priorityTask( Sched_Scheduler *scheduler, uint32_t task, uint8_t priority )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( priority < READY_LEVELS ) && ( actual_task != NULL ) && actual_task->used )
+    {
+        uint8_t previous = actual_task->priority;
+
+        actual_task->priority = priority;
+        exit = ( actual_task->wcet == 0 ) || Sched_analyse( scheduler, NULL, NULL );
+
+        if ( exit == 0 )
+        {
+            actual_task->priority = previous;               // The task set would not fit
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief WCET task function
+ * 
+ * This function declares the worst case execution time of a task, so the deadline and the
+ * priority can be set before the task joins the admission analysis
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param wcet[in] Worst case execution time in us, 0 to take the task out of the analysis
+ * 
+ * @retval 1 if the time has been changed correctly, or 0 if the task set would not be schedulable
+*/
+uint8_t Sched_wcetTask( Sched_Scheduler *scheduler, uint32_t task, Sched_Time wcet )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( actual_task != NULL ) && actual_task->used )
+    {
+        Sched_Time previous = actual_task->wcet;
+
+        actual_task->wcet = wcet;
+        exit = ( wcet == 0 ) || Sched_analyse( scheduler, NULL, NULL );
+
+        if ( exit == 0 )
+        {
+            actual_task->wcet = previous;                   // The task set would not fit
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Pin task function
+ * 
+ * This function keeps a task on the same worker when the scheduler runs with a worker pool.
+ * The worker has to be one of the pool, without a pool yet it is checked again when the
+ * scheduler starts and the task is unpinned if the pool does not have it
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to pin
+ * @param worker[in] Worker number starting from 0, or POOL_ANY_WORKER to let any worker run it
+ * 
+ * @retval 1 if the task has been pinned correctly, or 0 otherwise
+*/
+uint8_t Sched_pinTask( Sched_Scheduler *scheduler, uint32_t task, uint8_t worker )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    uint8_t workers = ( scheduler->pool != NULL ) ? scheduler->pool->workers : POOL_WORKERS_MAX;
+
+    if( ( ( worker < workers ) || ( worker == POOL_ANY_WORKER ) ) && ( actual_task != NULL ) && actual_task->used )
+    {
+        actual_task->job.worker = worker;
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Stats task function
+ * 
+ * This function starts recording the execution statistics of a task: number of runs, run
+ * time, lateness from its release and overruns
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to measure
+ * @param stats[in] Pointer to a Stats_Record variable to store the statistics, NULL to stop recording
+ * 
+ * @retval 1 if the statistics have been attached correctly, or 0 otherwise
+*/
+uint8_t Sched_statsTask( Sched_Scheduler *scheduler, uint32_t task, Stats_Record *stats )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( actual_task != NULL ) && actual_task->used )
+    {
+        if ( stats != NULL )
+        {
+            Stats_initRecord( stats );
+        }
+
+        actual_task->stats = stats;
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Catch-up task function
+ * 
+ * This function sets what a task does with the periods it missed because the scheduler was
+ * late: run once and resync to the next slot, skip them or run every one of them
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param catchup[in] SCHED_CATCHUP_RESYNC, SCHED_CATCHUP_SKIP or SCHED_CATCHUP_BURST
+ * 
+ * @retval 1 if the policy has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_catchupTask( Sched_Scheduler *scheduler, uint32_t task, uint8_t catchup )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( catchup <= SCHED_CATCHUP_BURST ) && ( actual_task != NULL ) && actual_task->used )
+    {
+        actual_task->catchup = catchup;
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Budget task function
+ * 
+ * This function sets how long every run of a task may take. A run over the budget is counted
+ * in the task statistics and reported to the handler, by the watchdog thread while it still
+ * runs or once it returns, and the task can be stopped like Sched_stopTask when it returns
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param budget[in] Execution time in us, 0 for no budget
+ * @param action[in] SCHED_OVERRUN_RECORD or SCHED_OVERRUN_STOP
+ * @param overrunPtr[in] Function called with the task handle on every overrun, NULL for none
+ * 
+ * @retval 1 if the budget has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_budgetTask( Sched_Scheduler *scheduler, uint32_t task, Sched_Time budget, uint8_t action, void (*overrunPtr)( uint32_t task ) )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( action <= SCHED_OVERRUN_STOP ) && ( actual_task != NULL ) && actual_task->used )
+    {
+        atomic_store( &actual_task->overrunAction, action );
+        atomic_store( &actual_task->overrunPtr, overrunPtr );
+        atomic_store( &actual_task->budget, budget );          // The watchdog and the workers can read it while the task runs
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Trigger task function
+ * 
+ * This function makes a task run when a queue is written instead of on its period. The
+ * writes can come from any thread, the task is dispatched on the next loop iteration without
+ * waiting for the next tick. The period is still used as the EDF deadline. A task depending
+ * on other tasks can not be triggered by a queue, nor by a queue that already has a listener
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to change
+ * @param queue[in] Pointer to the queue that triggers the task, NULL to run it periodically again
+ * 
+ * @retval 1 if the task has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_triggerTask( Sched_Scheduler *scheduler, uint32_t task, Que_Queue *queue )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( actual_task != NULL ) && actual_task->used && ( ( actual_task->depends == 0 ) || ( queue == NULL ) ) &&
+        ( ( queue == NULL ) || ( queue == actual_task->queue ) || ( queue->Notify == NULL ) ) )
+    {
+        if ( ( actual_task->queue != NULL ) && ( actual_task->queue != queue ) )
+        {
+            Sched_unlistenQueue( actual_task->queue, actual_task, NULL, NULL );
+        }
+
+        if ( ( queue != NULL ) && ( queue != actual_task->queue ) )
+        {
+            Queue_setListener( queue, Sched_notify, actual_task );
+        }
+        else
+        {
+            Sched_alignTask( scheduler, actual_task );       // Back on its slots
+        }
+
+        actual_task->queue = queue;
+        actual_task->phased = 0;
+        scheduler->cyclicDirty = 1;
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Depend task function
+ * 
+ * This function makes a task run after another one in every activation instead of on its
+ * period. Once every task it depends on finished, the task is released on the same tick and
+ * the tasks depending on it after it, so a chain or a graph of tasks runs in topological
+ * order. Without a worker pool the graph runs in one dispatch, with it the independent
+ * branches run in parallel. The task goes back to its period once the tasks it depends on
+ * are unregistered. The period is still used as the EDF deadline. An activation that
+ * completes while the previous one of the task did not run yet is counted as skipped. The
+ * tasks it depends on can have different periods, the activation completes once each of
+ * them finished at least once
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task that has to wait
+ * @param after[in] The handle of the task it has to wait for
+ * 
+ * @retval 1 if the dependency has been added correctly, or 0 if a handle is not valid, the
+ *         task is triggered by a queue, the dependency exists, it would close a cycle, the
+ *         other task already has SCHED_SUCCESSORS_MAX tasks depending on it or the task
+ *         already depends on SCHED_DEPENDS_MAX tasks
+*/
+uint8_t Sched_dependTask( Sched_Scheduler *scheduler, uint32_t task, uint32_t after )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    Sched_Task *before = Sched_taskOf( scheduler, after );
+    uint8_t exit = 0;
+
+    if( ( actual_task != NULL ) && ( before != NULL ) && actual_task->used && before->used && ( actual_task->queue == NULL ) &&
+        ( before->successors < SCHED_SUCCESSORS_MAX ) && ( actual_task->depends < SCHED_DEPENDS_MAX ) )
+    {
+        scheduler->visits++;                            // New search, no task visited yet
+        exit = ( Sched_reaches( scheduler, actual_task, before ) == 0 );
+
+        for ( uint8_t i = 0; ( i < before->successors ) && exit; i++ )
+        {
+            exit = ( before->successor[ i ] != actual_task );
+        }
+    }
+
+    if ( exit )
+    {
+        uint32_t bit = 1u;
+
+        while ( actual_task->dependMask & bit )
+        {
+            bit <<= 1;                                  // First bit free
+        }
+
+        before->successor[ before->successors ] = actual_task;
+        before->successorBit[ before->successors++ ] = bit;
+        actual_task->depends++;
+        actual_task->dependMask |= bit;
+        atomic_store( &actual_task->finished, 0 );      // The activation starts over with the new dependency
+        scheduler->cyclicDirty = 1;                     // Not on the frame table anymore
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Path task function
+ * 
+ * This function starts recording the latency of the activations a task runs for, from the
+ * release of the tasks that started the activation to the end of the task run. On the last
+ * task of a graph it is the critical path latency of every activation, the activations
+ * longer than the period count as overruns
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param task[in] The handle of the task you want to measure
+ * @param stats[in] Pointer to a Stats_Record variable to store the latencies as run times, NULL to stop recording
+ * 
+ * @retval 1 if the statistics have been attached correctly, or 0 otherwise
+*/
+uint8_t Sched_pathTask( Sched_Scheduler *scheduler, uint32_t task, Stats_Record *stats )
+{
+    Sched_Task *actual_task = Sched_taskOf( scheduler, task );
+    uint8_t exit = 0;
+
+    if( ( actual_task != NULL ) && actual_task->used )
+    {
+        if ( stats != NULL )
+        {
+            Stats_initRecord( stats );
+        }
+
+        actual_task->pathStats = stats;
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Table scheduler function
+ * 
+ * This function gives the scheduler a static task table built with table.h. The init
+ * functions of the table run here, the tasks run from the next tick on along with the
+ * registered tasks. Sched_initScheduler drops the table
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param table[in] Pointer to the table, NULL to drop the current one
+ * 
+ * @retval 1 if the table has been set correctly, or 0 if it was built for another tick
+*/
+uint8_t Sched_tableScheduler( Sched_Scheduler *scheduler, const Sched_Table *table )
+{
+    uint8_t exit = 0;
+
+    if ( ( table == NULL ) || ( table->tick == scheduler->base ) )
+    {
+        scheduler->table = table;
+        scheduler->tableTick = scheduler->ticksCount;
+
+        if ( table != NULL )
+        {
+            table->initPtr();
+        }
+
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Register fd function
+ * 
+ * This function watches a file descriptor from the scheduler loop, the callback is called
+ * on the scheduler thread every time the fd is ready while the scheduler waits for its next
+ * tick. The fd stays registered until it is unregistered, it must be unregistered before it
+ * is closed
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param fd[in] File descriptor to watch
+ * @param events[in] SCHED_FD_READ and/or SCHED_FD_WRITE
+ * @param callbackPtr[in] Function called with the fd and its ready events
+ * 
+ * @retval 1 if the fd has been registered correctly, or 0 if there are no free sources, the
+ *         fd is already registered or it can not be watched
+*/
+uint8_t Sched_registerFd( Sched_Scheduler *scheduler, int fd, uint8_t events, void (*callbackPtr)( int fd, uint8_t events ) )
+{
+    Sched_Source *empty = NULL;
+    uint8_t valid = ( fd >= 0 ) && ( callbackPtr != NULL );
+    uint8_t exit = 0;
+
+    for ( uint32_t i = 0; ( i < scheduler->sources ) && valid; i++ )
+    {
+        Sched_Source *source = scheduler->sourcePtr + i;
+
+        if ( source->used == 0 )
+        {
+            empty = ( empty == NULL ) ? source : empty;
+        }
+        else if ( source->fd == fd )
+        {
+            valid = 0;                                  // Already registered
+        }
+    }
+
+#ifdef __linux__
+    if ( valid && ( empty != NULL ) )
+    {
+        empty->fd = fd;
+        empty->events = events;
+        empty->callbackPtr = callbackPtr;
+
+        if ( ( scheduler->pollFd < 0 ) || Sched_watch( scheduler, fd, Sched_pollEvents( events ), empty ) )     // Running, watch it now
+        {
+            empty->used = 1;
+            exit = 1;
+        }
+    }
+#endif
+
+    return exit;
+}
+
+
+/**
+ * @brief Unregister fd function
+ * 
+ * This function stops watching a file descriptor
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param fd[in] File descriptor to stop watching
+ * 
+ * @retval 1 if the fd has been unregistered correctly, or 0 if it was not registered
+*/
+uint8_t Sched_unregisterFd( Sched_Scheduler *scheduler, int fd )
+{
+    uint8_t exit = 0;
+
+    for ( uint32_t i = 0; ( i < scheduler->sources ) && ( exit == 0 ); i++ )
+    {
+        Sched_Source *source = scheduler->sourcePtr + i;
+
+        if ( source->used && ( source->fd == fd ) )
+        {
+#ifdef __linux__
+            if ( scheduler->pollFd >= 0 )
+            {
+                epoll_ctl( scheduler->pollFd, EPOLL_CTL_DEL, fd, NULL );
+            }
+#endif
+            source->used = 0;
+            exit = 1;
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Start scheduler function
+ * 
+ * This is the scheduler, this function manages the scheduler's timers and tasks.
+ * Ticks are due at absolute times from the scheduler start, so a late tick does not delay
+ * the following ones, and when the scheduler falls behind by more than a tick it jumps to
+ * the current one. Tasks are released on the slots start + k * period and the periods they
+ * miss are handled by their catch-up policy. Tasks triggered by a queue run as soon as the
+ * queue is written, between ticks if needed. Coroutines are resumed after the timers once
+ * what they wait for is over.
+ * When the tickless flag is set the scheduler sleeps until the next task or timer
+ * deadline instead of waking up on every tick. In simulated mode the scheduler time is a
+ * virtual clock that jumps straight to the next deadline, so it runs as fast as the work
+ * allows. Due tasks are run in the order of the
+ * scheduler policy, on the scheduler thread or on the worker pool if there is one. The
+ * function returns once the timeout is over and every submitted task has finished
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * 
+ * @retval None
+*/
+void Sched_startScheduler( Sched_Scheduler *scheduler )
+{
+    Sched_run( scheduler, Sched_timeoutOf( scheduler ) / scheduler->base );
+}
+
+
+/**
+ * @brief Run until function
+ * 
+ * This function runs the scheduler like Sched_startScheduler but until the given scheduler
+ * time instead of the timeout. It can be called again to go on from where it stopped, in
+ * simulated mode it returns as soon as the work up to that time is done.
+ * The time is in ms, Sched_runUntilUs takes it in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param time[in] Scheduler time in ms to run until, from the scheduler start
+ * 
+ * @retval None
+*/
+void Sched_runUntil( Sched_Scheduler *scheduler, uint32_t time )
+{
+    Sched_runUntilUs( scheduler, SCHED_MS( time ) );
+}
+
+
+/**
+ * @brief Run until us function
+ * 
+ * This function runs the scheduler like Sched_startScheduler but until the given scheduler
+ * time instead of the timeout. It can be called again to go on from where it stopped, in
+ * simulated mode it returns as soon as the work up to that time is done
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param time[in] Scheduler time in us to run until, from the scheduler start
+ * 
+ * @retval None
+*/
+void Sched_runUntilUs( Sched_Scheduler *scheduler, Sched_Time time )
+{
+    Sched_run( scheduler, time / scheduler->base );
+}
+
+
+/**
+ * @brief Step scheduler function
+ * 
+ * This function runs the scheduler up to the next tick with a task, a timer or a coroutine
+ * due, never beyond the timeout. Meant for simulated mode
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * 
+ * @retval 1 if a tick has been run, or 0 if the timeout was already reached
+*/
+uint8_t Sched_stepScheduler( Sched_Scheduler *scheduler )
+{
+    uint64_t last = Sched_timeoutOf( scheduler ) / scheduler->base;
+    uint8_t exit = 0;
+
+    if ( scheduler->ticksCount < last )
+    {
+        Sched_run( scheduler, scheduler->ticksCount + Sched_nextDeadline( scheduler, last ) );
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Load scheduler function
+ * 
+ * This function gets the utilization of the scheduler thread, the part of the time it was
+ * running tasks, timers, coroutines and fd callbacks instead of waiting or running the idle
+ * hook
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param seconds[in] Seconds to look back, like 1, 10 or 60, up to STATS_SECONDS
+ * 
+ * @retval The utilization in parts per million
+*/
+uint32_t Sched_loadScheduler( Sched_Scheduler *scheduler, uint8_t seconds )
+{
+    return Stats_getLoad( &scheduler->load, seconds );
+}
+
+
+/**
+ * @brief Headroom scheduler function
+ * 
+ * This function gets the capacity the schedulability analysis of the active policy leaves
+ * for more tasks, from the declared worst case execution times. Under FIFO and the priority
+ * policy it is the utilization left, under EDF the density left at the tightest deadline
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * 
+ * @retval The headroom in parts per million, 0 if the task set is not schedulable
+*/
+uint32_t Sched_headroomScheduler( Sched_Scheduler *scheduler )
+{
+    uint32_t exit = 0;
+
+    Sched_analyse( scheduler, NULL, &exit );
+
+    return exit;
+}
+
+
+/**
+ * @brief Jitter scheduler function
+ * 
+ * This function gets the worst delay seen from a tick being due to the scheduler starting
+ * it, the wake up latency of the thread plus any work that ran past the tick. In real-time
+ * mode scheduler->rtStatus tells which of SCHED_FIFO, the memory locking and the pinning
+ * were permitted
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * 
+ * @retval The worst tick jitter in ns since the scheduler was initialized
+*/
+uint64_t Sched_jitterScheduler( Sched_Scheduler *scheduler )
+{
+    return scheduler->maxJitter;
 }
 
+
 /**
- * @brief Init Scheduler function
+ * @brief Wakeups scheduler function
  * 
- * This funcitons initializes the scheduler
+ * This function gets how many ticks the scheduler loop has run. Without tickless mode it is
+ * every tick unless the loop fell behind and jumped some, in tickless mode only the ticks
+ * with work due, so the time spent running divided by it is the overhead of every tick
  * 
- * @param scheduler[in] Pointer to a Sched_Scheduler variable, this is the scheduler
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
  * 
- * @retval None
+ * @retval The ticks run since the scheduler was initialized
 */
-void Sched_initScheduler( Sched_Scheduler *scheduler )
+uint64_t Sched_wakeupsScheduler( Sched_Scheduler *scheduler )
 {
-    scheduler->tasksCount = 0;
-    scheduler->ticksCount = 0;
+    return scheduler->wakeups;
 }
 
 
-
 /**
- * @brief Register task function
+ * @brief Frames scheduler function
  * 
- * This function register a task into the scheduler
+ * This function builds the frame table of the cyclic mode if the task set changed, so it can
+ * be checked to fit before running the scheduler
  * 
  * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param initPtr[in] Pointer to a function with no parameters and without return, this is the init function
- * @param taskPtr[in] Pointer to a function without parameters and without return value. This function will be executed periodically
- * @param period[in] How often you want the task run
  * 
- * @retval The number of the task you just registered. 0 in case of error
+ * @retval The minor frames of the hyperperiod, 0 if the cyclic mode is off, the hyperperiod is
+ *         too long or the table does not fit its buffer
 */
-uint8_t Sched_registerTask( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period )
+uint32_t Sched_framesScheduler( Sched_Scheduler *scheduler )
 {
-    Sched_Task *task = scheduler->taskPtr;
-    uint32_t tick = scheduler->tick;
-    uint32_t exit;
-
-    if ( ( period < tick ) || ( period % tick != 0 ) )
+    if ( scheduler->cyclic && scheduler->cyclicDirty )
     {
-        exit = 0;
-    }
-    else
-    {
-        
-        ( task + scheduler->tasksCount )->period = period;             // Seting the period
-        ( task + scheduler->tasksCount )->initFunc = initPtr;
-        ( task + scheduler->tasksCount )->taskFunc = taskPtr;
-        ( task + scheduler->tasksCount )->elapsed = 0;                 // Initializing time elapsed as 0
-        ( task + scheduler->tasksCount )->startFlag = 1;
-
-        ( task + scheduler->tasksCount )->initFunc();                  // Run init function
-        
-        exit = ++scheduler->tasksCount;
+        Sched_buildFrames( scheduler );
     }
 
-    return exit;
-    
-
-
+    return scheduler->cyclic ? scheduler->cyclicFrames : 0u;
 }
 
 
 /**
- * @brief Stop task function
+ * @brief Spawn coroutine function
  * 
- * This function stops a scheduler's task
+ * This function starts a coroutine, its body runs from SCHED_CORO_BEGIN on the next time the
+ * scheduler resumes coroutines. It gets a zeroed frame from the frame arena that lives until
+ * it finishes
  * 
  * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param task[in] The number of the task you want to stop
+ * @param func[in] Coroutine body
+ * @param arg[in] Argument the body can read from coro->arg
  * 
- * @retval 1 if the task has been stopped correctly, or 0 otherwise
+ * @retval 1 if the coroutine has been started correctly, or 0 if there are no free coroutines
 */
-uint8_t Sched_stopTask( Sched_Scheduler *scheduler, uint8_t task )
+uint8_t Sched_spawnCoro( Sched_Scheduler *scheduler, void (*func)( Sched_Coro *coro ), void *arg )
 {
-    uint8_t exit;
+    Sched_Coro *coro = scheduler->freeCoro;
+    uint8_t exit = 0;
 
-    if( task < 1 || task >= scheduler->tasks )
+    if ( coro != NULL )
     {
-        exit = 0;
+        scheduler->freeCoro = coro->next;
     }
-    else
+    else if ( scheduler->corosCount < scheduler->coros )
     {
-        Sched_Task *actual_task =  (scheduler->taskPtr + task - 1);
+        coro = scheduler->coroPtr + scheduler->corosCount++;
+    }
 
-        actual_task->startFlag = 0;
+    if ( coro != NULL )
+    {
+        uint32_t slot = (uint32_t)( coro - scheduler->coroPtr );
+
+        coro->func = func;
+        coro->arg = arg;
+        coro->frame = NULL;
+        coro->line = 0;
+        coro->used = 1;
+        coro->scheduler = scheduler;
+        coro->queue = NULL;
+        atomic_store( &coro->triggered, 0 );
+        Wheel_initNode( &coro->node );
+
+        if ( scheduler->frameArena != NULL )
+        {
+            coro->frame = (uint8_t *)scheduler->frameArena + ( slot * scheduler->frameSize );
+            memset( coro->frame, 0, scheduler->frameSize );
+        }
+
+        Sched_resumeCoro( scheduler, coro );
         exit = 1;
     }
-    
 
     return exit;
-
 }
 
 
 /**
- * @brief Start task function
+ * @brief Sleep coroutine function
  * 
- * This function starts a secheduler's task
+ * This function makes a coroutine wait for the given scheduler time, use it through
+ * SCHED_CORO_SLEEP.
+ * The time is in ms, Sched_sleepCoroUs takes it in us
  * 
- * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param task[in] The number of the task you want to start
+ * @param coro[in] Pointer to the running coroutine
+ * @param time[in] Milliseconds to sleep, rounded up to ticks
  * 
- * @retval 1 if the task has been started correctly, or 0 otherwise
+ * @retval None
 */
-uint8_t Sched_startTask( Sched_Scheduler *scheduler, uint8_t task )
+void Sched_sleepCoro( Sched_Coro *coro, uint32_t time )
 {
-    uint8_t exit = 0;
-
-    if ( ( task >= 1 ) && ( task <= scheduler->tasks ) )
-    {
-        Sched_Task *actual_task =  (scheduler->taskPtr + task - 1);
+    Sched_sleepCoroUs( coro, SCHED_MS( time ) );
+}
 
-        actual_task->startFlag = 1;
 
-        exit = 1;
-    }
+/**
+ * @brief Sleep coroutine us function
+ * 
+ * This function makes a coroutine wait for the given scheduler time, use it through
+ * SCHED_CORO_SLEEP_US
+ * 
+ * @param coro[in] Pointer to the running coroutine
+ * @param time[in] Microseconds to sleep, rounded up to ticks
+ * 
+ * @retval None
+*/
+void Sched_sleepCoroUs( Sched_Coro *coro, Sched_Time time )
+{
+    Sched_Scheduler *scheduler = coro->scheduler;
+    Sched_Time ticks = ( time + scheduler->base - 1u ) / scheduler->base;
 
-    return exit;
+    coro->wait = SCHED_WAIT_SLEEP;
+    Wheel_insert( &scheduler->sleeps, &coro->node, (uint32_t)scheduler->ticksCount + ( ( ticks < SCHED_TICKS_MAX ) ? (uint32_t)ticks : SCHED_TICKS_MAX ) );
 }
 
+
 /**
- * @brief Period task function
+ * @brief Await timer function
  * 
- * This function changes a task's period
- * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param task[in] The number of the task you want to stop
- * @param period[in] Task periodicity
+ * This function makes a coroutine wait until a timer expires, use it through
+ * SCHED_CORO_AWAIT_TIMER. The coroutine is resumed at once if the timer is not registered or
+ * not running, a one-shot timer that already fired included
  * 
- * @retval 1 if the task has been stopped correctly, or 0 otherwise
+ * @param coro[in] Pointer to the running coroutine
+ * @param timer[in] The handle of the timer to wait for
+ * 
+ * @retval None
 */
-uint8_t Sched_periodTask( Sched_Scheduler *scheduler, uint8_t task, uint32_t period )
+void Sched_awaitTimer( Sched_Coro *coro, uint32_t timer )
 {
-   uint8_t exit = 0;
+    Sched_Scheduler *scheduler = coro->scheduler;
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );
 
-    if( (period % scheduler->tick == 0 ) && ( task >= 1 ) && ( task < scheduler->tasks ) )                         // Period has to be a multiple of tick
+    if ( ( actual_timer != NULL ) && actual_timer->used && actual_timer->startFlag )
     {
-        ( scheduler->taskPtr + task - 1 )->period = period;
-        exit = 1;
+        coro->wait = SCHED_WAIT_TIMER;
+        coro->next = actual_timer->waiters;
+        actual_timer->waiters = coro;
+    }
+    else
+    {
+        Sched_resumeCoro( scheduler, coro );
     }
-
-    return exit;
 }
 
 
 /**
- * @brief Start scheduler function
+ * @brief Await queue function
  * 
- * This is the scheduler, this function manages the scheduler's timers and tasks
+ * This function makes a coroutine wait until a queue is written, use it through
+ * SCHED_CORO_AWAIT_QUEUE. The coroutine listens to the queue until it finishes or waits for
+ * another queue, chained to the task or coroutines already listening to it
  * 
- * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param coro[in] Pointer to the running coroutine
+ * @param queue[in] Pointer to the queue to wait for
  * 
  * @retval None
 */
-void Sched_startScheduler( Sched_Scheduler *scheduler )
+void Sched_awaitQueue( Sched_Coro *coro, Que_Queue *queue )
 {
-    long time = milliseconds();
-
-    while ( 1 )
+    if ( coro->queue != queue )
     {
-        
-        // Tasks
-        for ( uint8_t i = 0; i < scheduler->tasksCount; i++ )
+        if ( coro->queue != NULL )
         {
+            Sched_unlistenQueue( coro->queue, coro, coro->prevNotify, coro->prevListener );
+        }
 
-            Sched_Task *actual_task = scheduler->taskPtr + i;
+        coro->prevNotify = queue->Notify;
+        coro->prevListener = queue->Listener;
+        Queue_setListener( queue, Sched_notifyCoro, coro );
+        coro->queue = queue;
+    }
 
-            if ( actual_task->startFlag )         // Run task only if starFlag is True 
-            {
-                if ( actual_task->elapsed >= actual_task->period )     
-                {
+    coro->wait = SCHED_WAIT_QUEUE;
 
-                    actual_task->taskFunc();                                // Run function 
-                    actual_task->elapsed = 0;
+    if ( Queue_isQueueEmpty( queue ) == 0 )
+    {
+        Sched_resumeCoro( coro->scheduler, coro );      // Written before listening
+    }
+}
 
-                }
-                else
-                {
-                    actual_task->elapsed += scheduler->tick;   // Counting time
-                }
 
-            }
-            
-        }
+/**
+ * @brief Register timer function
+ * 
+ * This function register a timer in the scheduler, once expired it fires on every tick
+ * until it is reloaded or stopped.
+ * The time is in ms, Sched_registerTimerUs takes it in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timeout[in] The time in ms the timer should run
+ * @param callbackPtr[in] The function that will be executed when the time is over
+ * 
+ * @retval The handle of the timer you just registered. 0 in case of error
+*/
+uint32_t Sched_registerTimer( Sched_Scheduler *scheduler, uint32_t timeout, void (*callbackPtr)(void) )
+{
+    return Sched_registerTimerUs( scheduler, SCHED_MS( timeout ), callbackPtr );
+}
 
 
-        // Timers
-        for ( uint8_t i = 0; i < scheduler->timers; i++ )
-        {
-            Sched_Timer *actual_timer = scheduler->timerPtr + i;
+/**
+ * @brief Register timer us function
+ * 
+ * This function register a timer in the scheduler, once expired it fires on every tick
+ * until it is reloaded or stopped
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timeout[in] The time in us the timer should run
+ * @param callbackPtr[in] The function that will be executed when the time is over
+ * 
+ * @retval The handle of the timer you just registered. 0 in case of error
+*/
+uint32_t Sched_registerTimerUs( Sched_Scheduler *scheduler, Sched_Time timeout, void (*callbackPtr)(void) )
+{
+    uint32_t exit = Sched_registerTimerModeUs( scheduler, timeout, SCHED_TIMER_HOLD, NULL );
 
-            if ( actual_timer->startFlag )         // Run task only if starFlag is True
-            {
-                if ( actual_timer->count == 0 )
-                {
-                    actual_timer->callbackPtr();
-                }
-                else
-                {
-                    actual_timer->count -= scheduler->tick; // Subtracting elapsed time from timeout
-                }
+    if ( exit != 0 )
+    {
+        scheduler->timerPtr[ SCHED_HANDLE_SLOT( exit ) ].callbackPtr = callbackPtr;
+    }
 
-            }
+    return exit;
+}
 
-        }
+
+/**
+ * @brief Register timer mode function
+ * 
+ * This function registers a new timer that expires in the given mode. A one-shot timer
+ * fires once every time it is started. A periodic timer keeps firing every timeout from the
+ * tick it expired, without drift, and when the scheduler jumps over some of its periods
+ * it fires once with the number of expirations, like a timerfd. Timers are registered
+ * stopped.
+ * The time is in ms, Sched_registerTimerModeUs takes it in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timeout[in] Timeout in ms, multiple of tick
+ * @param mode[in] SCHED_TIMER_HOLD, SCHED_TIMER_ONESHOT or SCHED_TIMER_PERIODIC
+ * @param expiredPtr[in] Callback with the expirations since its last call
+ * 
+ * @retval The handle of the timer, or 0 if the timer could not be registered
+*/
+uint32_t Sched_registerTimerMode( Sched_Scheduler *scheduler, uint32_t timeout, uint8_t mode, void (*expiredPtr)( uint32_t expirations ) )
+{
+    return Sched_registerTimerModeUs( scheduler, SCHED_MS( timeout ), mode, expiredPtr );
+}
+
+
+/**
+ * @brief Register timer mode us function
+ * 
+ * This function registers a new timer that expires in the given mode. A one-shot timer
+ * fires once every time it is started. A periodic timer keeps firing every timeout from the
+ * tick it expired, without drift, and when the scheduler jumps over some of its periods
+ * it fires once with the number of expirations, like a timerfd. Timers are registered
+ * stopped
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timeout[in] Timeout in us, multiple of tick
+ * @param mode[in] SCHED_TIMER_HOLD, SCHED_TIMER_ONESHOT or SCHED_TIMER_PERIODIC
+ * @param expiredPtr[in] Callback with the expirations since its last call
+ * 
+ * @retval The handle of the timer, or 0 if the timer could not be registered
+*/
+uint32_t Sched_registerTimerModeUs( Sched_Scheduler *scheduler, Sched_Time timeout, uint8_t mode, void (*expiredPtr)( uint32_t expirations ) )
+{
+   uint32_t exit = 0;
+   Sched_Timer *actual_timer = NULL;
 
 
-        if (scheduler->ticksCount >= ( scheduler->timeout / scheduler->tick))
+    if ( timeout % scheduler->base == 0 && timeout >= scheduler->base && timeout / scheduler->base <= SCHED_TICKS_MAX && mode <= SCHED_TIMER_PERIODIC )      // Timeout has to be multiple of tick
+    {
+        if ( scheduler->freeTimer != 0 )
         {
-            break;          // Finish the scheduler
+            actual_timer = scheduler->timerPtr + scheduler->freeTimer - 1u;       // Reuse a free timer
+            scheduler->freeTimer = actual_timer->nextFree;
         }
-
-        while ( milliseconds() - time < scheduler->tick )        // Wait for the tick
+        else if ( ( scheduler->timersCount < scheduler->timers ) && ( scheduler->timersCount < SCHED_SLOTS_MAX ) )
         {
-            // Wait tick seconds
+            actual_timer = scheduler->timerPtr + scheduler->timersCount++;
         }
+    }
+
+    if ( actual_timer != NULL )
+    {
+
+        actual_timer->timeout = timeout;
+        actual_timer->count = timeout;
+        actual_timer->callbackPtr = NULL;
+        actual_timer->expiredPtr = expiredPtr;
+        actual_timer->mode = mode;
+        actual_timer->startFlag = 0;
+        actual_timer->stats = NULL;
+        actual_timer->waiters = NULL;
+        actual_timer->slack = 0;
+        actual_timer->used = 1;
+        
 
-        time = milliseconds();
-        scheduler->ticksCount++;
         
+        exit = SCHED_HANDLE( actual_timer - scheduler->timerPtr, actual_timer->generation );
     }
+
+    return exit;
 }
 
 
 /**
- * @brief Register timer function
+ * @brief Unregister timer function
  * 
- * This function register a timer in the scheduler
+ * This function removes a timer from the scheduler, its handle stops being valid and its
+ * slot is reused by the next registrations. Coroutines waiting for it are resumed
  * 
  * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param timeout[in] The time the timer should run
- * @param callbackPtr[in] The function that will be executed when the time is over
+ * @param timer[in] The handle of the timer you want to remove
  * 
- * @retval The number of the timer you just registered. 0 in case of error
+ * @retval 1 if the timer has been removed correctly, or 0 otherwise
 */
-uint8_t Sched_registerTimer( Sched_Scheduler *scheduler, uint32_t timeout, void (*callbackPtr)(void) )
+uint8_t Sched_unregisterTimer( Sched_Scheduler *scheduler, uint32_t timer )
 {
-   uint8_t exit = 0;
-   Sched_Timer *actual_timer = scheduler->timerPtr + timerID;
-
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );
+    uint8_t exit = 0;
 
-    if ( timeout % scheduler->tick == 0 && timeout >= scheduler->tick )             // Timeout has to be multiple of tick
+    if ( ( actual_timer != NULL ) && actual_timer->used )
     {
-
-        actual_timer->timeout = timeout;
-        actual_timer->count = timeout;
-        actual_timer->callbackPtr = callbackPtr;
+        Wheel_remove( &scheduler->wheel, &actual_timer->node );
+        Sched_wakeWaiters( scheduler, actual_timer );          // It will not expire anymore
         actual_timer->startFlag = 0;
-        
-
-        
-        exit = ++timerID;
+        actual_timer->used = 0;
+        actual_timer->generation = ( actual_timer->generation + 1u ) & SCHED_GENERATION_MASK;
+        actual_timer->nextFree = scheduler->freeTimer;
+        scheduler->freeTimer = (uint32_t)( actual_timer - scheduler->timerPtr ) + 1u;
+        exit = 1;
     }
 
     return exit;
@@ -288,20 +4057,39 @@ uint8_t Sched_registerTimer( Sched_Scheduler *scheduler, uint32_t timeout, void
 /**
  * @brief Get timer function
  * 
+ * This function gets the time remeaning of the timer.
+ * The time is in ms, Sched_getTimerUs gets it in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timer[in] The handle of the timer you want to start
+ * 
+ * @retval The time remeaning of the timer in ms
+*/
+uint32_t Sched_getTimer( Sched_Scheduler *scheduler, uint32_t timer )
+{
+    return (uint32_t)( Sched_getTimerUs( scheduler, timer ) / SCHED_MS( 1 ) );
+}
+
+
+/**
+ * @brief Get timer us function
+ * 
  * This function gets the time remeaning of the timer
  * 
  * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param timer[in] The number of the timer you want to start
+ * @param timer[in] The handle of the timer you want to start
  * 
- * @retval The time remeaning of the timer
+ * @retval The time remeaning of the timer in us
 */
-uint32_t Sched_getTimer( Sched_Scheduler *scheduler, uint8_t timer )
+Sched_Time Sched_getTimerUs( Sched_Scheduler *scheduler, uint32_t timer )
 { 
-    uint32_t exit = 0;
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );
+    Sched_Time exit = 0;
     
-    if ( ( timer <= scheduler->timers ) && ( timer > 0 ) )
+    if ( actual_timer != NULL )
     {
-        exit = (scheduler->timerPtr + timer - 1)->count;
+        Sched_syncTimer( scheduler, actual_timer );
+        exit = actual_timer->count;
     }
     
     return exit;
@@ -311,26 +4099,47 @@ uint32_t Sched_getTimer( Sched_Scheduler *scheduler, uint8_t timer )
 /**
  * @brief Reload timer function
  * 
+ * This function realoads the timer's count and it can be used to change it's period.
+ * The time is in ms, Sched_reloadTimerUs takes it in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timer[in] The handle of the timer you want to start
+ * @param timeout[in] The time in ms the timer counts before executing the callback function
+ * 
+ * @retval 1 if the task has been reloaded correctly, or 0 otherwise
+*/
+uint8_t Sched_reloadTimer( Sched_Scheduler *scheduler, uint32_t timer, uint32_t timeout )
+{
+    return Sched_reloadTimerUs( scheduler, timer, SCHED_MS( timeout ) );
+}
+
+
+/**
+ * @brief Reload timer us function
+ * 
  * This function realoads the timer's count and it can be used to change it's period
  * 
  * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param timer[in] The number of the timer you want to start
- * @param timeout[in] The time the timer count before executing the callback function
+ * @param timer[in] The handle of the timer you want to start
+ * @param timeout[in] The time in us the timer counts before executing the callback function
  * 
  * @retval 1 if the task has been reloaded correctly, or 0 otherwise
 */
-uint8_t Sched_reloadTimer( Sched_Scheduler *scheduler, uint8_t timer, uint32_t timeout )
+uint8_t Sched_reloadTimerUs( Sched_Scheduler *scheduler, uint32_t timer, Sched_Time timeout )
 {
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );       // Pointing to actual timer
     uint8_t reload = 0;
 
-    if ( ( timer > 0 ) && (timer <= scheduler->timers) && (timeout % scheduler->tick == 0) && (timeout > scheduler->tick) )   // Cheking if the timer is registered and if
-    {                                                                                                       // timeout is multiple of tick
-
-        Sched_Timer *actual_timer = (scheduler->timerPtr + timer - 1);       // Pointing to actual timer
+    if ( ( actual_timer != NULL ) && (timeout % scheduler->base == 0) && (timeout > scheduler->base) && ( timeout / scheduler->base <= SCHED_TICKS_MAX ) )   // Cheking if the timer is registered and if
+    {                                                                                                   // timeout is multiple of tick
 
         actual_timer->timeout = timeout;
         actual_timer->count = timeout;      // Reload count
 
+        if ( actual_timer->startFlag && actual_timer->used )
+        {
+            Sched_armTimer( scheduler, actual_timer );
+        }
 
         reload = 1;
     }
@@ -345,21 +4154,26 @@ uint8_t Sched_reloadTimer( Sched_Scheduler *scheduler, uint8_t timer, uint32_t t
  * This function enables the selected timer
  * 
  * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param timer[in] The number of the timer you want to start
+ * @param timer[in] The handle of the timer you want to start
  * 
  * @retval 1 if the timer has been started correctly, or 0 otherwise
 */
-uint8_t Sched_startTimer( Sched_Scheduler *scheduler, uint8_t timer )
+uint8_t Sched_startTimer( Sched_Scheduler *scheduler, uint32_t timer )
 { 
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );
     unsigned char exit = 0;
 
-    if ( ( timer > 0 ) && ( timer <= scheduler->timers ) )
+    if ( actual_timer != NULL )
     {
-        Sched_Timer *actual_timer = scheduler->timerPtr + timer - 1;
-
         
         actual_timer->count = actual_timer->timeout;             // Restart timer
         actual_timer->startFlag = 1;
+
+        if ( actual_timer->used )
+        {
+            Sched_armTimer( scheduler, actual_timer );
+        }
+
         exit = 1;
     }
     
@@ -371,24 +4185,116 @@ uint8_t Sched_startTimer( Sched_Scheduler *scheduler, uint8_t timer )
 /**
  * @brief Stop timer function
  * 
- * This function disables the selected timer
+ * This function disables the selected timer, the coroutines waiting for it are resumed
  * 
  * @param scheduler[in] Pointer to a Sched_Scheduler variable
- * @param timer[in] The number of the timer you want to start
+ * @param timer[in] The handle of the timer you want to start
  * 
  * @retval 1 if the timer has been stipped correctly, or 0 otherwise
 */
-uint8_t Sched_stopTimer( Sched_Scheduler *scheduler, uint8_t timer )
+uint8_t Sched_stopTimer( Sched_Scheduler *scheduler, uint32_t timer )
 {
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );
     unsigned char exit = 0;
 
-    if ( ( timer > 0 ) && ( timer <= scheduler->timers ) )
+    if ( actual_timer != NULL )
     {
-        Sched_Timer *actual_timer = scheduler->timerPtr + timer - 1;
-
+        Sched_syncTimer( scheduler, actual_timer );
+        Wheel_remove( &scheduler->wheel, &actual_timer->node );
+        Sched_wakeWaiters( scheduler, actual_timer );          // It will not expire until started again
         actual_timer->startFlag = 0;
+        exit = 1;
     }
     
     return exit;
 
 }
+
+
+/**
+ * @brief Stats timer function
+ * 
+ * This function starts recording the execution statistics of a timer callback: number of
+ * runs, run time and lateness from its expiry
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timer[in] The handle of the timer you want to measure
+ * @param stats[in] Pointer to a Stats_Record variable to store the statistics, NULL to stop recording
+ * 
+ * @retval 1 if the statistics have been attached correctly, or 0 otherwise
+*/
+uint8_t Sched_statsTimer( Sched_Scheduler *scheduler, uint32_t timer, Stats_Record *stats )
+{
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );
+    uint8_t exit = 0;
+
+    if ( actual_timer != NULL )
+    {
+        if ( stats != NULL )
+        {
+            Stats_initRecord( stats );
+        }
+
+        actual_timer->stats = stats;
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief Slack timer function
+ * 
+ * This function lets a timer fire up to slack ms after it is due, so timers whose windows
+ * overlap expire on the same tick with one wakeup and their callbacks run together. Periodic
+ * timers keep their period from the time they are due, so the slack does not add up.
+ * The time is in ms, Sched_slackTimerUs takes it in us
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timer[in] The handle of the timer
+ * @param slack[in] Time in ms the timer may fire late, multiple of tick, 0 to fire on time
+ * 
+ * @retval 1 if the slack has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_slackTimer( Sched_Scheduler *scheduler, uint32_t timer, uint32_t slack )
+{
+    return Sched_slackTimerUs( scheduler, timer, SCHED_MS( slack ) );
+}
+
+
+/**
+ * @brief Slack timer us function
+ * 
+ * This function lets a timer fire up to slack us after it is due, so timers whose windows
+ * overlap expire on the same tick with one wakeup and their callbacks run together. Periodic
+ * timers keep their period from the time they are due, so the slack does not add up
+ * 
+ * @param scheduler[in] Pointer to a Sched_Scheduler variable
+ * @param timer[in] The handle of the timer
+ * @param slack[in] Time in us the timer may fire late, multiple of tick, 0 to fire on time
+ * 
+ * @retval 1 if the slack has been changed correctly, or 0 otherwise
+*/
+uint8_t Sched_slackTimerUs( Sched_Scheduler *scheduler, uint32_t timer, Sched_Time slack )
+{
+    Sched_Timer *actual_timer = Sched_timerOf( scheduler, timer );
+    uint8_t exit = 0;
+
+    if ( ( actual_timer != NULL ) && ( slack % scheduler->base == 0 ) )
+    {
+        actual_timer->slack = slack;
+
+        if ( Wheel_isLinked( &actual_timer->node ) )
+        {
+            uint32_t fire = Sched_coalesce( scheduler, actual_timer, actual_timer->due );
+
+            Wheel_remove( &scheduler->wheel, &actual_timer->node );
+            Wheel_insert( &scheduler->wheel, &actual_timer->node, ( (int32_t)( fire - scheduler->wheel.now ) > 0 ) ? fire : scheduler->wheel.now );
+        }
+
+        exit = 1;
+    }
+
+    return exit;
+}
@@ -1,62 +1,321 @@
 #include <stdint.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "queue.h"
+#include "wheel.h"
+#include "ready.h"
+#include "pool.h"
+#include "stats.h"
+#include "trace.h"
 
 #ifndef SCHEDULER_H_
 #define SCHEDULER_H_
 
 
+/* TIME BASE */
+typedef uint64_t Sched_Time;    /*!< times and periods in us, taken by the functions ending in Us, the others keep taking ms */
+
+#define SCHED_US( us )          ( (Sched_Time)( us ) )                  /*!< time in us */
+#define SCHED_MS( ms )          ( (Sched_Time)( ms ) * 1000u )          /*!< time in ms */
+#define SCHED_SEC( s )          ( (Sched_Time)( s ) * 1000000u )        /*!< time in seconds */
+
+/* POLICIES */
+#define SCHED_POLICY_FIFO       READY_FIFO      /*!< due tasks run in registration order */
+#define SCHED_POLICY_EDF        READY_EDF       /*!< due tasks run earliest deadline first */
+#define SCHED_POLICY_PRIORITY   READY_PRIORITY  /*!< due tasks run highest priority first */
+
+/* CATCH-UP POLICIES */
+#define SCHED_CATCHUP_RESYNC    0u      /*!< missed periods run once and the task resyncs to the next slot */
+#define SCHED_CATCHUP_SKIP      1u      /*!< missed periods are dropped until the next slot */
+#define SCHED_CATCHUP_BURST     2u      /*!< every missed period runs back to back */
+
+/* HANDLES */
+#define SCHED_HANDLE_BITS       20u                                     /*!< low bits of a handle with the slot number + 1 */
+#define SCHED_SLOTS_MAX         ( ( 1ul << SCHED_HANDLE_BITS ) - 1u )   /*!< maximum number of task or timer slots */
+#define SCHED_GENERATION_MASK   0xFFFu                                  /*!< generation bits, the high bits of a handle */
+
+/* OVERRUN ACTIONS */
+#define SCHED_OVERRUN_RECORD    0u      /*!< a run over budget is recorded and reported to the overrun handler */
+#define SCHED_OVERRUN_STOP      1u      /*!< a run over budget is also stopped like Sched_stopTask once it returns */
+
+/* REAL-TIME STATUS */
+#define SCHED_RT_FIFO           0x01u   /*!< the scheduler thread runs as SCHED_FIFO */
+#define SCHED_RT_LOCKED         0x02u   /*!< the process memory is locked */
+#define SCHED_RT_PINNED         0x04u   /*!< the scheduler thread is pinned to scheduler->cpu */
+
+/* TIMER MODES */
+#define SCHED_TIMER_HOLD        0u      /*!< once expired the timer fires on every tick until it is reloaded or stopped */
+#define SCHED_TIMER_ONESHOT     1u      /*!< the timer fires once and stops */
+#define SCHED_TIMER_PERIODIC    2u      /*!< the timer fires every timeout, rearmed from its expiry tick */
+
+/* FD SOURCES */
+#define SCHED_FD_READ           0x01u       /*!< the fd can be read */
+#define SCHED_FD_WRITE          0x02u       /*!< the fd can be written */
+#define SCHED_FD_ERROR          0x04u       /*!< the fd failed or was hung up, always reported */
+
+/* DEPENDENCIES */
+#define SCHED_SUCCESSORS_MAX    4u          /*!< tasks that can depend on the same task */
+#define SCHED_DEPENDS_MAX       32u         /*!< tasks the same task can depend on */
+
+/* COROUTINES */
+#define SCHED_CORO_DONE         0xFFFFu     /*!< resume point of a finished coroutine */
+
+/**
+  * @defgroup SCHED COROUTINES brief coroutine body macros, the body goes between SCHED_CORO_BEGIN and
+  * SCHED_CORO_END and returns on every wait to be resumed after it. Locals do not survive a wait, keep
+  * them in the coroutine frame. Only one wait per source line
+  @{ */
+#define SCHED_CORO_BEGIN( coro )                switch ( ( coro )->line ) { case 0:
+#define SCHED_CORO_END( coro )                  } ( coro )->line = SCHED_CORO_DONE; return
+#define SCHED_CORO_WAIT( coro, wait )           do { wait; ( coro )->line = __LINE__; return; case __LINE__:; } while ( 0 )
+#define SCHED_CORO_SLEEP( coro, time )          SCHED_CORO_WAIT( coro, Sched_sleepCoro( coro, time ) )
+#define SCHED_CORO_SLEEP_US( coro, time )       SCHED_CORO_WAIT( coro, Sched_sleepCoroUs( coro, time ) )
+#define SCHED_CORO_AWAIT_TIMER( coro, timer )   SCHED_CORO_WAIT( coro, Sched_awaitTimer( coro, timer ) )
+#define SCHED_CORO_AWAIT_QUEUE( coro, queue, data ) \
+    do { ( coro )->line = __LINE__; case __LINE__: \
+        if ( Queue_readData( queue, data ) == 0 ) { Sched_awaitQueue( coro, queue ); return; } } while ( 0 )
+/**
+  @} */
+
+
 /* STRUCTURES */
+typedef struct _Sched_Source
+{
+    int fd;                     /*!< file descriptor to watch */
+    uint8_t events;             /*!< SCHED_FD_READ and/or SCHED_FD_WRITE */
+    uint8_t used;               /*!< 1 while the fd is registered */
+    void (*callbackPtr)( int fd, uint8_t events );     /*!< called from the scheduler loop with the ready events */
+} Sched_Source;
+
+
+typedef struct _Sched_Coro
+{
+    void (*func)( struct _Sched_Coro *coro );  /*!< coroutine body, resumed from its last wait */
+    void *arg;                  /*!< argument given when spawned */
+    void *frame;                /*!< zeroed frame from the arena for the state kept across waits, NULL without arena */
+    uint16_t line;              /*!< resume point, 0 to start and SCHED_CORO_DONE once finished */
+    uint8_t wait;               /*!< what the coroutine waits for */
+    uint8_t used;               /*!< 1 while the coroutine is running */
+    struct _AppSched_Scheduler *scheduler;     /*!< scheduler the coroutine runs in */
+    Wheel_Node node;            /*!< link to the sleep wheel while sleeping */
+    struct _Sched_Coro *next;   /*!< next coroutine to resume, on a timer wait list or on the free list */
+    Que_Queue *queue;           /*!< queue the coroutine listens to, NULL for none */
+    void (*prevNotify)( void *listener );  /*!< listener of the queue called after the coroutine, NULL for none */
+    void *prevListener;         /*!< parameter given to prevNotify */
+    atomic_uchar triggered;     /*!< 1 while the coroutine waits on the event list */
+    struct _Sched_Coro *nextEvent;  /*!< next coroutine on the event list */
+} Sched_Coro;
+
+
 typedef struct _AppSched_Timer
 {
-    uint32_t timeout;       /*!< timer timeout to decrement and reload when the timer is re-started */
-    uint32_t count;         /*!< actual timer decrement count */
+    Sched_Time timeout;     /*!< timer timeout in us to decrement and reload when the timer is re-started */
+    Sched_Time count;       /*!< actual timer decrement count in us, refreshed when the timer expires, stops or is read */
     uint8_t startFlag;     /*!< flag to start timer count */
     void(*callbackPtr)(void);  /*!< pointer to callback function function */
+    void (*expiredPtr)( uint32_t expirations );    /*!< callback with the expirations since the last call, used instead of callbackPtr when set */
+    uint8_t mode;           /*!< SCHED_TIMER_HOLD, SCHED_TIMER_ONESHOT or SCHED_TIMER_PERIODIC */
+    Stats_Record *stats;    /*!< execution statistics of the callback, NULL to not record them */
+    Wheel_Node node;        /*!< link to the scheduler timing wheel while the timer runs */
+    Sched_Coro *waiters;    /*!< coroutines waiting for the timer to expire */
+    uint16_t generation;    /*!< generation of the timer handle, changes when the timer is unregistered */
+    uint8_t used;           /*!< 1 while the timer is registered */
+    uint32_t nextFree;      /*!< next free timer + 1 while the timer is on the free list */
+    Sched_Time slack;       /*!< time in us the timer may fire late to share its tick with other timers, 0 to fire on time */
+    uint32_t due;           /*!< wheel tick the timer is due on while it runs, before the slack is applied */
 } Sched_Timer;
 
 
 typedef struct _task
 {
-    uint32_t period;          /*How often the task shopud run in ms*/
-    uint32_t elapsed;         /*the cuurent elapsed time*/
+    Sched_Time period;        /*How often the task shopud run in us*/
+    Sched_Time elapsed;       /*time from the release to the last run in us*/
     uint8_t startFlag;        /*flag to run task*/
     void (*initFunc)(void);   /*pointer to init task function*/
     void (*taskFunc)(void);   /*pointer to task function*/
-    uint32_t absLastTime;     /* Milliseconds that there was the last time the function were executed */
+    Sched_Time absLastTime;   /* Scheduler time in us of the last release slot, the next one is absLastTime + period */
+    Sched_Time deadline;      /* Relative deadline in us used by the EDF policy, 0 to use the period */
+    uint8_t priority;         /* Priority used by the priority policy, 0 is the highest */
+    Ready_Node readyNode;     /* Link to the ready queue while the task is due */
+    Pool_Job job;             /* Job to run the task on the worker pool */
+    Stats_Record *stats;      /* Execution statistics, NULL to not record them */
+    uint64_t releaseTime;     /* Monotonic ns the last release was due */
+    uint8_t catchup;          /* What to do with missed periods, SCHED_CATCHUP_RESYNC, SCHED_CATCHUP_SKIP or SCHED_CATCHUP_BURST */
+    uint32_t pending;         /* Releases still to run */
+    uint16_t generation;      /* Generation of the task handle, changes when the task is unregistered */
+    uint8_t used;             /* 1 while the task is registered */
+    uint32_t nextFree;        /* Next free task + 1 while the task is on the free list */
+    Que_Queue *queue;         /* Queue whose writes release the task instead of its period, NULL for a periodic task */
+    struct _AppSched_Scheduler *scheduler;     /* Scheduler the task is registered in */
+    atomic_uchar triggered;   /* 1 while the task waits on the event list */
+    struct _task *nextEvent;  /* Next task on the event list */
+    Sched_Time wcet;          /* Worst case execution time in us checked by the admission analysis, 0 if not declared */
+    _Atomic Sched_Time budget;    /* Execution time in us every run may take, 0 for no budget, read by the workers and the watchdog */
+    atomic_uchar overrunAction;   /* What to do once a run takes longer than the budget, SCHED_OVERRUN_RECORD or SCHED_OVERRUN_STOP */
+    void (*_Atomic overrunPtr)( uint32_t task );   /* Called with the task handle once a run takes longer than the budget, NULL for none */
+    _Atomic uint64_t started; /* Monotonic ns the current run started, 0 while the task is not running */
+    atomic_uchar overran;     /* 1 once the current run was found over its budget */
+    uint8_t phased;           /* 1 once the cyclic mode gave the task its phase */
+    struct _task *successor[ SCHED_SUCCESSORS_MAX ];   /* Tasks that depend on this one */
+    uint32_t successorBit[ SCHED_SUCCESSORS_MAX ];     /* Bit of this task in the dependMask of every successor */
+    uint8_t successors;       /* Tasks in successor */
+    uint32_t depends;         /* Tasks to finish before every release, 0 for a task released by its period or its queue */
+    uint32_t dependMask;      /* One bit per task it depends on */
+    atomic_uint finished;     /* Bits of the tasks it depends on that finished in the current activation */
+    _Atomic uint64_t activation;    /* Earliest release in ns of the activations that reached the task, UINT64_MAX for none */
+    uint64_t activated;       /* Release in ns of the activation of the last release */
+    uint64_t runRelease;      /* Release in ns of the current run, taken when it is dispatched */
+    uint64_t runOrigin;       /* Release in ns of the activation of the current run, taken when it is dispatched */
+    Stats_Record *pathStats;  /* Latency from the activation release to the end of every run, NULL to not record it */
+    uint32_t visit;           /* Last dependency search that went through the task */
     //Add more elements if required
 } Sched_Task;
 
 
+typedef struct _Sched_Table
+{
+    Sched_Time tick;                                    /*!< tick in us the table was built for */
+    void (*initPtr)(void);                              /*!< runs the init function of every task */
+    void (*dispatchPtr)( uint64_t from, uint64_t to );  /*!< runs the tasks with a release slot after tick from up to tick to */
+    uint32_t (*nextPtr)( uint64_t tick );               /*!< ticks from the given one to the next release slot of any task */
+} Sched_Table;
+
+
 typedef struct _AppSched_Scheduler
 {
-    uint8_t tasks;         /*number of task to handle*/
-    uint32_t tick;          /*the time base in ms*/
-    uint8_t tasksCount;    /*internal task counter*/ 
-    uint32_t timeout;      /*the number of milliseconds the scheduler should run*/
+    uint32_t tasks;         /*number of task to handle, up to SCHED_SLOTS_MAX*/
+    uint32_t tick;          /*the time base in ms, used when tickUs is 0*/
+    Sched_Time tickUs;      /*the time base in us, 0 to use tick*/
+    uint32_t tasksCount;    /*task slots handed out, registered or on the free list*/ 
+    uint32_t timeout;       /*the number of milliseconds the scheduler should run, used when timeoutUs is 0*/
+    Sched_Time timeoutUs;   /*the number of microseconds the scheduler should run, 0 to use timeout*/
+    Sched_Time base;        /*the time base in us in force, taken by Sched_initScheduler*/
     Sched_Task *taskPtr;            /*Pointer to buffer for the TCB tasks*/
-    uint8_t timers;        /*number of software timer to use*/
+    uint32_t timers;        /*number of software timer to use, up to SCHED_SLOTS_MAX*/
     Sched_Timer *timerPtr;       /*Pointer to buffer timer array*/
-    uint32_t ticksCount;         /* Ticks count */ 
+    uint32_t timersCount;        /* Timer slots handed out, registered or on the free list */
+    uint32_t freeTask;           /* First task of the free list + 1, 0 when empty */
+    uint32_t freeTimer;          /* First timer of the free list + 1, 0 when empty */
+    Sched_Task *_Atomic events;  /* Tasks whose queue was written, newest first */
+    Sched_Task *retry;           /* Event tasks that found their job busy on the worker pool */
+    uint8_t primed;              /* 1 once the lock and the condition variables are set up, 0 in a zeroed scheduler */
+    pthread_mutex_t lock;        /* Protects the wait for events */
+    pthread_cond_t wake;         /* Signaled when a queue is written */
+    uint32_t coros;              /* Number of coroutines to handle */
+    Sched_Coro *coroPtr;         /* Pointer to buffer for the coroutines */
+    void *frameArena;            /* Buffer of coros * frameSize bytes for the coroutine frames, NULL if they need none */
+    uint32_t frameSize;          /* Bytes of every coroutine frame */
+    uint32_t corosCount;         /* Coroutine slots handed out */
+    Sched_Coro *freeCoro;        /* Free coroutine slots */
+    Wheel sleeps;                /* Timing wheel with the sleeping coroutines */
+    Sched_Coro *resumeHead;      /* First coroutine to resume */
+    Sched_Coro *resumeTail;      /* Last coroutine to resume */
+    Sched_Coro *_Atomic coroEvents;     /* Coroutines whose queue was written, newest first */
+    uint64_t ticksCount;         /* Ticks count */ 
+    uint8_t tickless;            /* 1 to sleep until the next task or timer deadline instead of waking every tick */
+    Wheel wheel;                 /* Timing wheel with the running timers */
+    uint8_t policy;              /* Order to run the due tasks, SCHED_POLICY_FIFO, SCHED_POLICY_EDF or SCHED_POLICY_PRIORITY, read by Sched_initScheduler only, changes take effect on the next init */
+    Ready_Queue ready;           /* Due tasks waiting to run */
+    Pool *pool;                  /* Worker pool to run the tasks in parallel, NULL to run them on the scheduler thread */
+    uint64_t epoch;              /* Monotonic ns tick 0 was due, used to measure the lateness */
+    uint32_t sources;            /* Number of fds to watch, 0 to wait without epoll */
+    Sched_Source *sourcePtr;     /* Pointer to buffer for the fd sources */
+    int pollFd;                  /* epoll instance while the scheduler runs with sources, -1 otherwise */
+    int tickFd;                  /* timerfd armed for the next tick */
+    int wakeFd;                  /* eventfd written when a queue is written */
+    uint8_t simulated;           /* 1 to run on a virtual clock that jumps to the next deadline instead of the wall clock */
+    _Atomic uint64_t clock;      /* Virtual clock in ns for the simulated mode, read by the workers */
+    Trace_Ring *trace;           /* Ring for the events of the scheduler thread, NULL to not record them */
+    Trace_Ring *workerTrace;     /* Ring for every worker of the pool, NULL to not record the tasks run on the pool */
+    void (*idlePtr)(void);       /* Called every time the scheduler goes idle with no work due, NULL for none */
+    Stats_Load load;             /* Busy and idle time of the scheduler thread */
+    uint32_t watchdog;           /* Period in ms the watchdog thread checks the running tasks, used when watchdogUs is 0, both 0 to check the budgets once the tasks finish */
+    Sched_Time watchdogUs;       /* Period in us the watchdog thread checks the running tasks, 0 to use watchdog */
+    pthread_t watchdogThread;    /* Thread checking the budgets while the scheduler runs */
+    pthread_cond_t watchdogWake; /* Signaled to finish the watchdog thread */
+    uint8_t watchdogStop;        /* 1 to finish the watchdog thread */
+    atomic_uint tasksWatched;    /* Task slots set up by a registration, the ones the watchdog checks */
+    uint8_t realtime;            /* 1 to run the scheduler thread as SCHED_FIFO with its memory locked, Linux only */
+    uint8_t rtPriority;          /* SCHED_FIFO priority above the lowest one in real-time mode */
+    int cpu;                     /* CPU to pin the scheduler thread to in real-time mode, negative to not pin it */
+    uint8_t rtStatus;            /* What the real-time mode got, SCHED_RT_FIFO, SCHED_RT_LOCKED and SCHED_RT_PINNED bits */
+    uint64_t maxJitter;          /* Worst delay in ns from a tick being due to the scheduler starting it */
+    uint64_t wakeups;            /* Ticks the scheduler loop has run, every tick or only the ones with work in tickless mode */
+    const Sched_Table *table;    /* Static task table built with table.h, NULL for none */
+    uint64_t tableTick;          /* Last tick the static task table was dispatched on */
+    uint8_t cyclic;              /* 1 to release the periodic tasks from a frame table over the hyperperiod instead of checking all of them every tick */
+    uint32_t *cyclicPtr;         /* Buffer for the frame table of the cyclic mode */
+    uint32_t cyclicSize;         /* Entries of the frame table buffer, frames + 1 plus one per task release in the hyperperiod */
+    uint32_t cyclicFrames;       /* Minor frames of the frame table, 0 while there is none */
+    uint32_t minorTicks;         /* Ticks of a minor frame */
+    uint64_t cyclicTick;         /* First tick whose frame has not been looked up */
+    uint8_t cyclicDirty;         /* 1 when the task set changed after the frame table was built */
+    uint32_t visits;             /* Dependency searches done, marks the tasks every search went through */
     //Add more private elements if required
 } Sched_Scheduler;
 
 
-long miliseconds( void );
+long milliseconds( void );
 
 
 /* Scheduler */
 void Sched_initScheduler( Sched_Scheduler *scheduler );
-uint8_t Sched_registerTask( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period );
-uint8_t Sched_stopTask( Sched_Scheduler *scheduler, uint8_t task );
-uint8_t Sched_startTask( Sched_Scheduler *scheduler, uint8_t task );
-uint8_t Sched_periodTask( Sched_Scheduler *scheduler, uint8_t task, uint32_t period );
+void Sched_deinitScheduler( Sched_Scheduler *scheduler );
+uint32_t Sched_registerTask( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period );
+uint32_t Sched_registerTaskUs( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), Sched_Time period );
+uint32_t Sched_registerTaskWcet( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period, Sched_Time wcet );
+uint32_t Sched_registerTaskWcetUs( Sched_Scheduler *scheduler, void (*initPtr)(void), void (*taskPtr)(void), Sched_Time period, Sched_Time wcet );
+uint8_t Sched_unregisterTask( Sched_Scheduler *scheduler, uint32_t task );
+uint8_t Sched_stopTask( Sched_Scheduler *scheduler, uint32_t task );
+uint8_t Sched_startTask( Sched_Scheduler *scheduler, uint32_t task );
+uint8_t Sched_periodTask( Sched_Scheduler *scheduler, uint32_t task, uint32_t period );
+uint8_t Sched_periodTaskUs( Sched_Scheduler *scheduler, uint32_t task, Sched_Time period );
+uint8_t Sched_deadlineTask( Sched_Scheduler *scheduler, uint32_t task, uint32_t deadline );
+uint8_t Sched_deadlineTaskUs( Sched_Scheduler *scheduler, uint32_t task, Sched_Time deadline );
+uint8_t Sched_priorityTask( Sched_Scheduler *scheduler, uint32_t task, uint8_t priority );
+uint8_t Sched_wcetTask( Sched_Scheduler *scheduler, uint32_t task, Sched_Time wcet );
+uint8_t Sched_pinTask( Sched_Scheduler *scheduler, uint32_t task, uint8_t worker );
+uint8_t Sched_statsTask( Sched_Scheduler *scheduler, uint32_t task, Stats_Record *stats );
+uint8_t Sched_catchupTask( Sched_Scheduler *scheduler, uint32_t task, uint8_t catchup );
+uint8_t Sched_budgetTask( Sched_Scheduler *scheduler, uint32_t task, Sched_Time budget, uint8_t action, void (*overrunPtr)( uint32_t task ) );
+uint8_t Sched_triggerTask( Sched_Scheduler *scheduler, uint32_t task, Que_Queue *queue );
+uint8_t Sched_dependTask( Sched_Scheduler *scheduler, uint32_t task, uint32_t after );
+uint8_t Sched_pathTask( Sched_Scheduler *scheduler, uint32_t task, Stats_Record *stats );
+uint8_t Sched_tableScheduler( Sched_Scheduler *scheduler, const Sched_Table *table );
+uint8_t Sched_registerFd( Sched_Scheduler *scheduler, int fd, uint8_t events, void (*callbackPtr)( int fd, uint8_t events ) );
+uint8_t Sched_unregisterFd( Sched_Scheduler *scheduler, int fd );
 void Sched_startScheduler( Sched_Scheduler *scheduler );
+void Sched_runUntil( Sched_Scheduler *scheduler, uint32_t time );
+void Sched_runUntilUs( Sched_Scheduler *scheduler, Sched_Time time );
+uint8_t Sched_stepScheduler( Sched_Scheduler *scheduler );
+uint32_t Sched_loadScheduler( Sched_Scheduler *scheduler, uint8_t seconds );
+uint32_t Sched_headroomScheduler( Sched_Scheduler *scheduler );
+uint64_t Sched_jitterScheduler( Sched_Scheduler *scheduler );
+uint64_t Sched_wakeupsScheduler( Sched_Scheduler *scheduler );
+uint32_t Sched_framesScheduler( Sched_Scheduler *scheduler );
+
+/* Coroutines */
+uint8_t Sched_spawnCoro( Sched_Scheduler *scheduler, void (*func)( Sched_Coro *coro ), void *arg );
+void Sched_sleepCoro( Sched_Coro *coro, uint32_t time );
+void Sched_sleepCoroUs( Sched_Coro *coro, Sched_Time time );
+void Sched_awaitTimer( Sched_Coro *coro, uint32_t timer );
+void Sched_awaitQueue( Sched_Coro *coro, Que_Queue *queue );
 
 /* Timer */
-uint8_t Sched_registerTimer( Sched_Scheduler *scheduler, uint32_t timeout, void (*callbackPtr)(void) );
-uint32_t Sched_getTimer( Sched_Scheduler *scheduler, uint8_t timer );
-uint8_t Sched_reloadTimer( Sched_Scheduler *scheduler, uint8_t timer, uint32_t timeout );
-uint8_t Sched_startTimer( Sched_Scheduler *scheduler, uint8_t timer );
-uint8_t Sched_stopTimer( Sched_Scheduler *scheduler, uint8_t timer );
+uint32_t Sched_registerTimer( Sched_Scheduler *scheduler, uint32_t timeout, void (*callbackPtr)(void) );
+uint32_t Sched_registerTimerUs( Sched_Scheduler *scheduler, Sched_Time timeout, void (*callbackPtr)(void) );
+uint32_t Sched_registerTimerMode( Sched_Scheduler *scheduler, uint32_t timeout, uint8_t mode, void (*expiredPtr)( uint32_t expirations ) );
+uint32_t Sched_registerTimerModeUs( Sched_Scheduler *scheduler, Sched_Time timeout, uint8_t mode, void (*expiredPtr)( uint32_t expirations ) );
+uint8_t Sched_unregisterTimer( Sched_Scheduler *scheduler, uint32_t timer );
+uint32_t Sched_getTimer( Sched_Scheduler *scheduler, uint32_t timer );
+Sched_Time Sched_getTimerUs( Sched_Scheduler *scheduler, uint32_t timer );
+uint8_t Sched_reloadTimer( Sched_Scheduler *scheduler, uint32_t timer, uint32_t timeout );
+uint8_t Sched_reloadTimerUs( Sched_Scheduler *scheduler, uint32_t timer, Sched_Time timeout );
+uint8_t Sched_startTimer( Sched_Scheduler *scheduler, uint32_t timer );
+uint8_t Sched_stopTimer( Sched_Scheduler *scheduler, uint32_t timer );
+uint8_t Sched_statsTimer( Sched_Scheduler *scheduler, uint32_t timer, Stats_Record *stats );
+uint8_t Sched_slackTimer( Sched_Scheduler *scheduler, uint32_t timer, uint32_t slack );
+uint8_t Sched_slackTimerUs( Sched_Scheduler *scheduler, uint32_t timer, Sched_Time slack );
 
 
 #endif
\ No newline at end of file
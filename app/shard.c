@@ -0,0 +1,252 @@
+/**
+ * @file    shard.c
+ * @brief   Sharded runtime's source code
+ *
+ * This is a set of independent schedulers, one per shard, every one of them running on its
+ * own thread pinned to a CPU. The shards share no state while they run, tasks are placed on
+ * the shard with the lowest utilization when they are registered
+ */
+
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         /* CPU affinity */
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#ifdef __linux__
+#include <sched.h>
+#endif
+#include "scheduler.h"
+#include "shard.h"
+
+
+/**
+ * @brief Shard running on the calling thread, SHARD_NONE outside the shard threads
+*/
+static _Thread_local uint8_t currentShard = SHARD_NONE;
+
+
+/**
+ * @brief   Shard thread function
+ *
+ * Runs the scheduler of a shard until its timeout
+ *
+ * @param   arg[in] Pointer to the Shard of the thread
+ *
+ * @retval  NULL
+ */
+static void *Shard_thread( void *arg )
+{
+    Shard *self = arg;
+
+    currentShard = self->index;
+    Sched_startScheduler( self->scheduler );
+
+    return NULL;
+}
+
+
+/**
+ * @brief   Spawn function
+ *
+ * Starts the thread of a shard pinned to its CPU, or unpinned if the CPU can not be used
+ *
+ * @param   shard[in] Pointer to the Shard
+ *
+ * @retval  1 if the thread is running, 0 otherwise
+ */
+static uint8_t Shard_spawn( Shard *shard )
+{
+    uint8_t exit = 0;
+
+#ifdef __linux__
+    if ( ( shard->cpu >= 0 ) && ( shard->cpu < CPU_SETSIZE ) )
+    {
+        pthread_attr_t attr;
+        cpu_set_t cpus;
+
+        CPU_ZERO( &cpus );
+        CPU_SET( shard->cpu, &cpus );
+        pthread_attr_init( &attr );
+
+        if ( pthread_attr_setaffinity_np( &attr, sizeof( cpus ), &cpus ) == 0 )
+        {
+            exit = ( pthread_create( &shard->thread, &attr, Shard_thread, shard ) == 0 );
+        }
+
+        pthread_attr_destroy( &attr );
+    }
+#endif
+
+    if ( exit == 0 )
+    {
+        exit = ( pthread_create( &shard->thread, NULL, Shard_thread, shard ) == 0 );
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Init runtime function
+ *
+ * Initializes the runtime and the scheduler of every shard, the schedulers have to be
+ * configured like for Sched_initScheduler before
+ *
+ * @param   runtime[in] Pointer to a Shard_Runtime variable
+ * @param   schedulers[in] Scheduler of every shard
+ * @param   cpus[in] CPU of every shard, SHARD_ANY_CPU to not pin it, NULL to pin shard n to CPU n
+ * @param   shards[in] Number of shards, from 1 to SHARD_MAX
+ *
+ * @retval  1 if the runtime is ready, 0 otherwise
+ */
+uint8_t Shard_initRuntime( Shard_Runtime *runtime, Sched_Scheduler **schedulers, const int *cpus, uint8_t shards )
+{
+    uint8_t exit = 0;
+
+    if ( ( shards >= 1 ) && ( shards <= SHARD_MAX ) )
+    {
+        runtime->shards = shards;
+        runtime->running = 0;
+
+        for ( uint8_t i = 0; i < shards; i++ )
+        {
+            Shard *shard = &runtime->shard[ i ];
+
+            shard->scheduler = schedulers[ i ];
+            shard->cpu = ( cpus != NULL ) ? cpus[ i ] : i;
+            shard->index = i;
+            shard->load = 0;
+            Sched_initScheduler( shard->scheduler );
+        }
+
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Register task function
+ *
+ * Registers a task on the shard with the lowest utilization like Shard_registerTaskUs, with
+ * the period in ms
+ *
+ * @param   runtime[in] Pointer to a Shard_Runtime variable
+ * @param   initPtr[in] Init function of the task
+ * @param   taskPtr[in] Task function
+ * @param   period[in] Period in ms
+ * @param   cost[in] Expected execution time in us, 0 if unknown
+ * @param   shard[out] Shard the task was placed on, NULL if not needed
+ *
+ * @retval  The handle of the task on its shard scheduler, 0 if it could not be registered
+ */
+uint32_t Shard_registerTask( Shard_Runtime *runtime, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period, Sched_Time cost, uint8_t *shard )
+{
+    return Shard_registerTaskUs( runtime, initPtr, taskPtr, SCHED_MS( period ), cost, shard );
+}
+
+
+/**
+ * @brief   Register task us function
+ *
+ * Registers a task on the shard with the lowest utilization, ties go to the lowest shard.
+ * Tasks have to be registered before the runtime starts
+ *
+ * @param   runtime[in] Pointer to a Shard_Runtime variable
+ * @param   initPtr[in] Init function of the task
+ * @param   taskPtr[in] Task function
+ * @param   period[in] Period in us
+ * @param   cost[in] Expected execution time in us, 0 if unknown
+ * @param   shard[out] Shard the task was placed on, NULL if not needed
+ *
+ * @retval  The handle of the task on its shard scheduler, 0 if it could not be registered
+ */
+uint32_t Shard_registerTaskUs( Shard_Runtime *runtime, void (*initPtr)(void), void (*taskPtr)(void), Sched_Time period, Sched_Time cost, uint8_t *shard )
+{
+    Shard *target = &runtime->shard[ 0 ];
+    uint32_t exit = 0;
+
+    for ( uint8_t i = 1; i < runtime->shards; i++ )
+    {
+        if ( runtime->shard[ i ].load < target->load )
+        {
+            target = &runtime->shard[ i ];
+        }
+    }
+
+    exit = Sched_registerTaskUs( target->scheduler, initPtr, taskPtr, period );
+
+    if ( exit != 0 )
+    {
+        uint64_t load = ( cost * 1000000u ) / period;              // Parts per million
+
+        target->load += ( load != 0 ) ? load : 1u;
+
+        if ( shard != NULL )
+        {
+            *shard = target->index;
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Start runtime function
+ *
+ * Starts the thread of every shard, every scheduler runs until its own timeout
+ *
+ * @param   runtime[in] Pointer to a Shard_Runtime variable
+ *
+ * @retval  1 if every shard is running, 0 otherwise
+ */
+uint8_t Shard_startRuntime( Shard_Runtime *runtime )
+{
+    uint8_t exit = 1;
+
+    for ( uint8_t i = runtime->running; ( i < runtime->shards ) && exit; i++ )
+    {
+        exit = Shard_spawn( &runtime->shard[ i ] );
+        runtime->running += exit;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Wait runtime function
+ *
+ * Blocks until the scheduler of every running shard finishes
+ *
+ * @param   runtime[in] Pointer to a Shard_Runtime variable
+ *
+ * @retval  None
+ */
+void Shard_waitRuntime( Shard_Runtime *runtime )
+{
+    for ( uint8_t i = 0; i < runtime->running; i++ )
+    {
+        pthread_join( runtime->shard[ i ].thread, NULL );
+    }
+
+    runtime->running = 0;
+}
+
+
+/**
+ * @brief   Current shard function
+ *
+ * Tells which shard is running the calling thread
+ *
+ * @retval  The shard number, SHARD_NONE if called outside the shard threads
+ */
+uint8_t Shard_currentShard( void )
+{
+    return currentShard;
+}
@@ -0,0 +1,41 @@
+#include <stdint.h>
+#include <pthread.h>
+#include "scheduler.h"
+
+#ifndef SHARD_H_
+#define SHARD_H_
+
+
+#define SHARD_MAX           16u         /*!< maximum number of shards */
+#define SHARD_ANY_CPU       -1          /*!< the shard thread is not pinned */
+#define SHARD_NONE          0xFFu       /*!< not running on a shard thread */
+
+
+/* STRUCTURES */
+typedef struct _Shard
+{
+    Sched_Scheduler *scheduler; /*!< scheduler of the shard, configured by the user */
+    int cpu;                    /*!< CPU the shard thread is pinned to or SHARD_ANY_CPU */
+    uint8_t index;              /*!< shard number */
+    pthread_t thread;           /*!< shard thread */
+    uint64_t load;              /*!< utilization of the placed tasks in parts per million */
+} Shard;
+
+
+typedef struct _Shard_Runtime
+{
+    uint8_t shards;                 /*!< number of shards */
+    Shard shard[ SHARD_MAX ];       /*!< shards */
+    uint8_t running;                /*!< number of shard threads started */
+} Shard_Runtime;
+
+
+uint8_t Shard_initRuntime( Shard_Runtime *runtime, Sched_Scheduler **schedulers, const int *cpus, uint8_t shards );
+uint32_t Shard_registerTask( Shard_Runtime *runtime, void (*initPtr)(void), void (*taskPtr)(void), uint32_t period, Sched_Time cost, uint8_t *shard );
+uint32_t Shard_registerTaskUs( Shard_Runtime *runtime, void (*initPtr)(void), void (*taskPtr)(void), Sched_Time period, Sched_Time cost, uint8_t *shard );
+uint8_t Shard_startRuntime( Shard_Runtime *runtime );
+void Shard_waitRuntime( Shard_Runtime *runtime );
+uint8_t Shard_currentShard( void );
+
+
+#endif
@@ -0,0 +1,391 @@
+/**
+ * @file    stats.c
+ * @brief   Execution statistics source code
+ *
+ * This is the execution statistics of a task or a timer. Times are taken from the monotonic
+ * clock in nanoseconds and stored in fixed size log histograms with two buckets for every
+ * power of two, so percentiles are reported with less than 50% error and recording is O(1).
+ * The load keeps the busy and accounted time of the last seconds in a ring of one second
+ * buckets, so the utilization over any of them is exact
+ */
+
+
+#include <time.h>
+#include <stdint.h>
+#include "stats.h"
+
+
+/**
+ * @brief   Bucket function
+ *
+ * Gets the histogram bucket of a value
+ *
+ * @param   value[in] Value in ns
+ *
+ * @retval  The bucket index, values too big go to the last bucket
+ */
+static uint32_t Stats_bucket( uint64_t value )
+{
+    uint32_t bucket = (uint32_t)value;
+
+    if ( value >= 2u )
+    {
+        uint32_t msb = 63u - (uint32_t)__builtin_clzll( value );
+
+        bucket = ( 2u * msb ) + (uint32_t)( ( value >> ( msb - 1u ) ) & 1u );
+    }
+
+    return ( bucket < STATS_BUCKETS ) ? bucket : ( STATS_BUCKETS - 1u );
+}
+
+
+/**
+ * @brief   Bucket top function
+ *
+ * Gets the biggest value a histogram bucket holds
+ *
+ * @param   bucket[in] The bucket index
+ *
+ * @retval  The biggest value of the bucket in ns
+ */
+static uint64_t Stats_bucketTop( uint32_t bucket )
+{
+    uint64_t top = bucket;
+
+    if ( bucket >= 2u )
+    {
+        uint32_t msb = bucket / 2u;
+        uint64_t half = 1ull << ( msb - 1u );
+
+        top = ( 1ull << msb ) + ( ( bucket & 1u ) * half ) + half - 1u;
+    }
+
+    return top;
+}
+
+
+/**
+ * @brief   Percentile function
+ *
+ * Gets the value below which the given percent of the histogram samples fall
+ *
+ * @param   histogram[in] Histogram to read
+ * @param   samples[in] Number of samples in the histogram
+ * @param   percent[in] Percentile from 0 to 100
+ * @param   max[in] Biggest sample, the result never goes beyond it
+ *
+ * @retval  The percentile in ns, 0 if there are no samples
+ */
+static uint64_t Stats_percentile( uint32_t *histogram, uint32_t samples, uint8_t percent, uint64_t max )
+{
+    uint64_t exit = 0;
+    uint64_t rank = ( ( (uint64_t)samples * percent ) + 99u ) / 100u;
+    uint64_t seen = 0;
+
+    if ( rank == 0 )
+    {
+        rank = 1;
+    }
+
+    for ( uint32_t bucket = 0; ( bucket < STATS_BUCKETS ) && ( samples != 0 ); bucket++ )
+    {
+        seen += histogram[ bucket ];
+
+        if ( seen >= rank )
+        {
+            exit = Stats_bucketTop( bucket );
+            exit = ( exit < max ) ? exit : max;
+            break;
+        }
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Move load function
+ *
+ * Moves the load to a new second, clearing the buckets of the seconds it leaves behind
+ *
+ * @param   load[in] Pointer to a Stats_Load variable
+ * @param   second[in] The new second
+ *
+ * @retval  None
+ */
+static void Stats_moveLoad( Stats_Load *load, uint64_t second )
+{
+    for ( uint32_t i = 0; ( load->second < second ) && ( i < STATS_SECONDS ); i++ )
+    {
+        uint32_t bucket = (uint32_t)( ++load->second % STATS_SECONDS );
+
+        load->busy[ bucket ] = 0;
+        load->total[ bucket ] = 0;
+    }
+
+    load->second = ( second > load->second ) ? second : load->second;
+}
+
+
+/**
+ * @brief   Init record function
+ *
+ * Clears the statistics
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ *
+ * @retval  None
+ */
+void Stats_initRecord( Stats_Record *stats )
+{
+    stats->runs = 0;
+    stats->overruns = 0;
+    stats->skipped = 0;
+    stats->exceeded = 0;
+    stats->minRun = UINT64_MAX;
+    stats->maxRun = 0;
+    stats->totalRun = 0;
+    stats->minLateness = UINT64_MAX;
+    stats->maxLateness = 0;
+
+    for ( uint32_t i = 0; i < STATS_BUCKETS; i++ )
+    {
+        stats->runHist[ i ] = 0;
+        stats->latenessHist[ i ] = 0;
+    }
+}
+
+
+/**
+ * @brief   Now function
+ *
+ * Reads the monotonic clock
+ *
+ * @retval  The monotonic time in ns
+ */
+uint64_t Stats_now( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( (uint64_t)now.tv_sec * 1000000000ull ) + (uint64_t)now.tv_nsec;
+}
+
+
+/**
+ * @brief   Add run function
+ *
+ * Records one execution
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ * @param   release[in] Time the execution was due in ns
+ * @param   start[in] Time the execution started in ns
+ * @param   end[in] Time the execution finished in ns
+ * @param   period[in] Period in ns, an execution longer than it counts as an overrun
+ *
+ * @retval  None
+ */
+void Stats_addRun( Stats_Record *stats, uint64_t release, uint64_t start, uint64_t end, uint64_t period )
+{
+    uint64_t run = end - start;
+    uint64_t lateness = ( start > release ) ? ( start - release ) : 0;
+
+    stats->runs++;
+    stats->totalRun += run;
+    stats->minRun = ( run < stats->minRun ) ? run : stats->minRun;
+    stats->maxRun = ( run > stats->maxRun ) ? run : stats->maxRun;
+    stats->minLateness = ( lateness < stats->minLateness ) ? lateness : stats->minLateness;
+    stats->maxLateness = ( lateness > stats->maxLateness ) ? lateness : stats->maxLateness;
+    stats->runHist[ Stats_bucket( run ) ]++;
+    stats->latenessHist[ Stats_bucket( lateness ) ]++;
+
+    if ( ( period != 0 ) && ( run > period ) )
+    {
+        stats->overruns++;
+    }
+}
+
+
+/**
+ * @brief   Add skipped function
+ *
+ * Records a release dropped because the previous one had not finished
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ *
+ * @retval  None
+ */
+void Stats_addSkipped( Stats_Record *stats )
+{
+    stats->skipped++;
+}
+
+
+/**
+ * @brief   Add exceeded function
+ *
+ * Records an execution that ran longer than its budget
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ *
+ * @retval  None
+ */
+void Stats_addExceeded( Stats_Record *stats )
+{
+    stats->exceeded++;
+}
+
+
+/**
+ * @brief   Get average function
+ *
+ * Gets the average execution time
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ *
+ * @retval  The average execution time in ns, 0 if there are no executions
+ */
+uint64_t Stats_getAverage( Stats_Record *stats )
+{
+    return ( stats->runs != 0 ) ? ( stats->totalRun / stats->runs ) : 0;
+}
+
+
+/**
+ * @brief   Get jitter function
+ *
+ * Gets the release jitter, the difference between the biggest and the smallest lateness
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ *
+ * @retval  The release jitter in ns, 0 if there are no executions
+ */
+uint64_t Stats_getJitter( Stats_Record *stats )
+{
+    return ( stats->runs != 0 ) ? ( stats->maxLateness - stats->minLateness ) : 0;
+}
+
+
+/**
+ * @brief   Get run percentile function
+ *
+ * Gets a percentile of the execution time
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ * @param   percent[in] Percentile from 0 to 100
+ *
+ * @retval  The percentile in ns
+ */
+uint64_t Stats_getRunPercentile( Stats_Record *stats, uint8_t percent )
+{
+    return Stats_percentile( stats->runHist, stats->runs, percent, stats->maxRun );
+}
+
+
+/**
+ * @brief   Get lateness percentile function
+ *
+ * Gets a percentile of the release lateness
+ *
+ * @param   stats[in] Pointer to a Stats_Record variable
+ * @param   percent[in] Percentile from 0 to 100
+ *
+ * @retval  The percentile in ns
+ */
+uint64_t Stats_getLatenessPercentile( Stats_Record *stats, uint8_t percent )
+{
+    return Stats_percentile( stats->latenessHist, stats->runs, percent, stats->maxLateness );
+}
+
+
+/**
+ * @brief   Init load function
+ *
+ * Clears the load and starts accounting from the given time
+ *
+ * @param   load[in] Pointer to a Stats_Load variable
+ * @param   now[in] Time in ns
+ *
+ * @retval  None
+ */
+void Stats_initLoad( Stats_Load *load, uint64_t now )
+{
+    for ( uint32_t i = 0; i < STATS_SECONDS; i++ )
+    {
+        load->busy[ i ] = 0;
+        load->total[ i ] = 0;
+    }
+
+    load->second = now / 1000000000ull;
+    load->mark = now;
+}
+
+
+/**
+ * @brief   Add load function
+ *
+ * Accounts the time since the last call as busy or idle, split among the seconds it spans
+ *
+ * @param   load[in] Pointer to a Stats_Load variable
+ * @param   now[in] Time in ns
+ * @param   busy[in] 1 if the time was busy, 0 if it was idle
+ *
+ * @retval  None
+ */
+void Stats_addLoad( Stats_Load *load, uint64_t now, uint8_t busy )
+{
+    uint64_t window = STATS_SECONDS * 1000000000ull;
+
+    if ( ( now > load->mark ) && ( now - load->mark > window ) )
+    {
+        load->mark = now - window;                      // Older time would be forgotten anyway
+    }
+
+    while ( load->mark < now )
+    {
+        uint64_t second = load->mark / 1000000000ull;
+        uint64_t end = ( second + 1u ) * 1000000000ull;
+        uint64_t part = ( ( end < now ) ? end : now ) - load->mark;
+        uint32_t bucket = (uint32_t)( second % STATS_SECONDS );
+
+        Stats_moveLoad( load, second );
+        load->total[ bucket ] += part;
+        load->busy[ bucket ] += busy ? part : 0u;
+        load->mark += part;
+    }
+}
+
+
+/**
+ * @brief   Get load function
+ *
+ * Gets the utilization over the last seconds, the current one included
+ *
+ * @param   load[in] Pointer to a Stats_Load variable
+ * @param   seconds[in] Seconds to look back, from 1 to STATS_SECONDS
+ *
+ * @retval  The busy part of the accounted time in parts per million, 0 if there is none
+ */
+uint32_t Stats_getLoad( Stats_Load *load, uint8_t seconds )
+{
+    uint64_t busy = 0;
+    uint64_t total = 0;
+
+    seconds = ( seconds < STATS_SECONDS ) ? seconds : STATS_SECONDS;
+
+    if ( seconds > load->second )
+    {
+        seconds = (uint8_t)( load->second + 1u );       // Not that many seconds yet
+    }
+
+    for ( uint32_t i = 0; i < seconds; i++ )
+    {
+        uint32_t bucket = (uint32_t)( ( load->second - i ) % STATS_SECONDS );
+
+        busy += load->busy[ bucket ];
+        total += load->total[ bucket ];
+    }
+
+    return ( total != 0 ) ? (uint32_t)( ( busy * 1000000ull ) / total ) : 0u;
+}
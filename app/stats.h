@@ -0,0 +1,51 @@
+#include <stdint.h>
+
+#ifndef STATS_H_
+#define STATS_H_
+
+
+#define STATS_BUCKETS   80u     /*!< histogram buckets, two per power of two of nanoseconds */
+#define STATS_SECONDS   60u     /*!< seconds of busy time kept for the load */
+
+
+/* STRUCTURES */
+typedef struct _Stats_Record
+{
+    uint32_t runs;                          /*!< number of executions */
+    uint32_t overruns;                      /*!< executions that took longer than the period */
+    uint32_t skipped;                       /*!< releases dropped because the previous one was still pending */
+    uint32_t exceeded;                      /*!< executions that ran longer than their budget */
+    uint64_t minRun;                        /*!< shortest execution time in ns */
+    uint64_t maxRun;                        /*!< longest execution time in ns */
+    uint64_t totalRun;                      /*!< sum of the execution times in ns */
+    uint64_t minLateness;                   /*!< smallest delay from the release to the execution start in ns */
+    uint64_t maxLateness;                   /*!< biggest delay from the release to the execution start in ns */
+    uint32_t runHist[ STATS_BUCKETS ];      /*!< histogram of the execution times */
+    uint32_t latenessHist[ STATS_BUCKETS ]; /*!< histogram of the release lateness */
+} Stats_Record;
+
+
+typedef struct _Stats_Load
+{
+    uint64_t busy[ STATS_SECONDS ];         /*!< busy ns of every one of the last seconds */
+    uint64_t total[ STATS_SECONDS ];        /*!< accounted ns of every one of the last seconds */
+    uint64_t second;                        /*!< second of the last accounted time */
+    uint64_t mark;                          /*!< time accounted up to in ns */
+} Stats_Load;
+
+
+void Stats_initRecord( Stats_Record *stats );
+uint64_t Stats_now( void );
+void Stats_addRun( Stats_Record *stats, uint64_t release, uint64_t start, uint64_t end, uint64_t period );
+void Stats_addSkipped( Stats_Record *stats );
+void Stats_addExceeded( Stats_Record *stats );
+uint64_t Stats_getAverage( Stats_Record *stats );
+uint64_t Stats_getJitter( Stats_Record *stats );
+uint64_t Stats_getRunPercentile( Stats_Record *stats, uint8_t percent );
+uint64_t Stats_getLatenessPercentile( Stats_Record *stats, uint8_t percent );
+void Stats_initLoad( Stats_Load *load, uint64_t now );
+void Stats_addLoad( Stats_Load *load, uint64_t now, uint8_t busy );
+uint32_t Stats_getLoad( Stats_Load *load, uint8_t seconds );
+
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file    table.h
+ * @brief   Static task table generator
+ *
+ * Builds a task table at compile time for a fixed set of periodic tasks. Define the table
+ * and include this header, once per table:
+ *
+ *     #define TABLE_NAME      appTable
+ *     #define TABLE_TICK      SCHED_MS( 100 )
+ *     #define TABLE_TASKS( TASK ) \
+ *         TASK( Init_1000ms, Task_1000ms, SCHED_MS( 1000 ) ) \
+ *         TASK( Init_2000ms, Task_2000ms, SCHED_MS( 2000 ) )
+ *     #include "table.h"
+ *
+ * and give it to the scheduler with Sched_tableScheduler( &scheduler, &appTable ). Every
+ * period is checked against the tick when compiling, there is no registration at run time
+ * and the tasks are called directly from the generated dispatch function, so the compiler
+ * can inline them. The tasks run on the scheduler thread in table order before the
+ * registered tasks of the same tick, without statistics, budgets or policies. A task whose
+ * release slots were jumped over runs once, like SCHED_CATCHUP_RESYNC
+ */
+
+
+#include <stdint.h>
+#include "scheduler.h"
+
+#ifndef TABLE_H_
+#define TABLE_H_
+
+
+/**
+  * @defgroup TABLE MACROS brief table generator helpers
+  @{ */
+#define TABLE_PASTE( name, suffix )     name##suffix
+#define TABLE_JOIN( name, suffix )      TABLE_PASTE( name, suffix )             /*!< pastes after expanding the name */
+#define TABLE_TICKS( period )           ( (uint64_t)( ( period ) / ( TABLE_TICK ) ) )   /*!< period in ticks */
+
+#define TABLE_CHECK( init, func, period ) \
+    _Static_assert( ( ( period ) >= ( TABLE_TICK ) ) && ( ( ( period ) % ( TABLE_TICK ) ) == 0u ), \
+                    "the period of " #func " is not a multiple of the table tick" );
+#define TABLE_INIT( init, func, period )    init();
+#define TABLE_RUN( init, func, period ) \
+    if ( ( to / TABLE_TICKS( period ) ) > ( from / TABLE_TICKS( period ) ) ) { func(); }
+#define TABLE_NEXT( init, func, period ) \
+    steps = ( TABLE_TICKS( period ) - ( tick % TABLE_TICKS( period ) ) < steps ) ? \
+            (uint32_t)( TABLE_TICKS( period ) - ( tick % TABLE_TICKS( period ) ) ) : steps;
+/**
+  @} */
+
+
+#endif
+
+
+#if defined( TABLE_NAME ) && defined( TABLE_TICK ) && defined( TABLE_TASKS )
+
+_Static_assert( ( TABLE_TICK ) > 0u, "the table tick can not be 0" );
+TABLE_TASKS( TABLE_CHECK )
+
+
+/**
+ * @brief   Runs the init function of every task of the table, in table order
+ */
+static void TABLE_JOIN( TABLE_NAME, _init )( void )
+{
+    TABLE_TASKS( TABLE_INIT )
+}
+
+
+/**
+ * @brief   Runs once every task of the table with a release slot after tick from up to tick to
+ */
+static void TABLE_JOIN( TABLE_NAME, _dispatch )( uint64_t from, uint64_t to )
+{
+    TABLE_TASKS( TABLE_RUN )
+}
+
+
+/**
+ * @brief   Gets the ticks from the given one to the next release slot of any task of the table
+ */
+static uint32_t TABLE_JOIN( TABLE_NAME, _next )( uint64_t tick )
+{
+    uint32_t steps = UINT32_MAX;
+
+    TABLE_TASKS( TABLE_NEXT )
+
+    return steps;
+}
+
+
+static const Sched_Table TABLE_NAME =
+{
+    TABLE_TICK,
+    TABLE_JOIN( TABLE_NAME, _init ),
+    TABLE_JOIN( TABLE_NAME, _dispatch ),
+    TABLE_JOIN( TABLE_NAME, _next )
+};
+
+#endif
+
+#undef TABLE_NAME
+#undef TABLE_TICK
+#undef TABLE_TASKS
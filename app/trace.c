@@ -0,0 +1,299 @@
+/**
+ * @file    trace.c
+ * @brief   Trace recorder's source code
+ *
+ * This is a recorder of scheduler events. Every thread writes compact binary records with
+ * timestamp counter values into its own single producer single consumer ring, so recording
+ * takes no locks and a full ring drops records instead of blocking. Rings are saved to a
+ * binary file that is converted offline to the Chrome trace event JSON format
+ */
+
+
+#include <time.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif
+#include "trace.h"
+
+
+/**
+ * @brief Ring of the calling thread, NULL to not record its events
+*/
+_Thread_local Trace_Ring *Trace_currentRing = NULL;
+
+/**
+ * @brief Timestamp counter calibration, done once
+*/
+static pthread_once_t calibrated = PTHREAD_ONCE_INIT;
+static uint64_t frequency;
+static uint64_t base;
+
+
+/**
+ * @brief   Monotonic function
+ *
+ * Reads the monotonic clock
+ *
+ * @retval  The monotonic time in ns
+ */
+static uint64_t Trace_monotonic( void )
+{
+    struct timespec now;
+
+    clock_gettime( CLOCK_MONOTONIC, &now );
+
+    return ( (uint64_t)now.tv_sec * 1000000000ull ) + (uint64_t)now.tv_nsec;
+}
+
+
+/**
+ * @brief   Calibrate function
+ *
+ * Measures the timestamp counter frequency against the monotonic clock and takes the
+ * counter value of time 0
+ *
+ * @retval  None
+ */
+static void Trace_calibrate( void )
+{
+    struct timespec wait = { 0, 10000000 };            // 10ms
+    uint64_t start = Trace_monotonic();
+    uint64_t ticks = Trace_now();
+    uint64_t elapsed;
+
+    nanosleep( &wait, NULL );
+    elapsed = Trace_monotonic() - start;
+    ticks = Trace_now() - ticks;
+
+    frequency = ( elapsed != 0 ) ? (uint64_t)( ( (double)ticks * 1e9 ) / (double)elapsed ) : 1000000000ull;
+    base = Trace_now();
+}
+
+
+/**
+ * @brief   Init ring function
+ *
+ * Initializes an empty ring, the buffer, its size and the thread number have to be set
+ * before
+ *
+ * @param   ring[in] Pointer to a Trace_Ring variable
+ *
+ * @retval  None
+ */
+void Trace_initRing( Trace_Ring *ring )
+{
+    pthread_once( &calibrated, Trace_calibrate );
+
+    atomic_store( &ring->head, 0 );
+    atomic_store( &ring->tail, 0 );
+    ring->dropped = 0;
+}
+
+
+/**
+ * @brief   Bind ring function
+ *
+ * Makes the calling thread record its events on a ring, only one thread can write a ring
+ *
+ * @param   ring[in] Pointer to the ring, NULL to stop recording
+ *
+ * @retval  None
+ */
+void Trace_bindRing( Trace_Ring *ring )
+{
+    Trace_currentRing = ring;
+}
+
+
+/**
+ * @brief   Record function
+ *
+ * Writes an event on a ring, called only from the thread that owns the ring
+ *
+ * @param   ring[in] Pointer to a Trace_Ring variable
+ * @param   event[in] TRACE_TICK_BEGIN ... TRACE_QUEUE_READ
+ * @param   id[in] Tick, task, timer or queue of the event
+ *
+ * @retval  None
+ */
+void Trace_record( Trace_Ring *ring, uint8_t event, uint32_t id )
+{
+    uint32_t head = atomic_load_explicit( &ring->head, memory_order_relaxed );
+
+    if ( ( head - atomic_load_explicit( &ring->tail, memory_order_acquire ) ) < ring->size )
+    {
+        Trace_Record *record = &ring->buffer[ head & ( ring->size - 1u ) ];
+
+        record->time = Trace_now();
+        record->id = id;
+        record->event = event;
+        record->thread = ring->thread;
+        record->reserved = 0;
+        atomic_store_explicit( &ring->head, head + 1u, memory_order_release );     // Publish the record
+    }
+    else
+    {
+        ring->dropped++;
+    }
+}
+
+
+/**
+ * @brief   Read ring function
+ *
+ * Takes the oldest record of a ring, it can be called from any single reader thread
+ *
+ * @param   ring[in] Pointer to a Trace_Ring variable
+ * @param   record[out] The record
+ *
+ * @retval  1 if a record was taken, 0 if the ring is empty
+ */
+uint8_t Trace_readRing( Trace_Ring *ring, Trace_Record *record )
+{
+    uint32_t tail = atomic_load_explicit( &ring->tail, memory_order_relaxed );
+    uint8_t exit = 0;
+
+    if ( tail != atomic_load_explicit( &ring->head, memory_order_acquire ) )
+    {
+        *record = ring->buffer[ tail & ( ring->size - 1u ) ];
+        atomic_store_explicit( &ring->tail, tail + 1u, memory_order_release );     // Give the slot back
+        exit = 1;
+    }
+
+    return exit;
+}
+
+
+/**
+ * @brief   Now function
+ *
+ * Reads the timestamp counter, the monotonic clock in ns where there is none
+ *
+ * @retval  The timestamp counter value
+ */
+uint64_t Trace_now( void )
+{
+#if defined( __x86_64__ ) || defined( __i386__ )
+    return __rdtsc();
+#elif defined( __aarch64__ )
+    uint64_t ticks;
+
+    __asm__ volatile ( "mrs %0, cntvct_el0" : "=r" ( ticks ) );
+
+    return ticks;
+#else
+    return Trace_monotonic();
+#endif
+}
+
+
+/**
+ * @brief   Write header function
+ *
+ * Starts a trace file with the timestamp counter calibration
+ *
+ * @param   file[in] File to write
+ *
+ * @retval  None
+ */
+void Trace_writeHeader( FILE *file )
+{
+    Trace_Header header;
+
+    pthread_once( &calibrated, Trace_calibrate );
+
+    header.magic = TRACE_MAGIC;
+    header.version = TRACE_VERSION;
+    header.frequency = frequency;
+    header.base = base;
+
+    fwrite( &header, sizeof( header ), 1, file );
+}
+
+
+/**
+ * @brief   Write ring function
+ *
+ * Moves the records of a ring to a trace file, after its header
+ *
+ * @param   ring[in] Pointer to a Trace_Ring variable
+ * @param   file[in] File to write
+ *
+ * @retval  Number of records written
+ */
+uint32_t Trace_writeRing( Trace_Ring *ring, FILE *file )
+{
+    Trace_Record record;
+    uint32_t count = 0;
+
+    while ( Trace_readRing( ring, &record ) )
+    {
+        count += (uint32_t)fwrite( &record, sizeof( record ), 1, file );
+    }
+
+    return count;
+}
+
+
+/**
+ * @brief   Convert function
+ *
+ * Converts a binary trace file to the Chrome trace event JSON format. Ticks, tasks and
+ * timers become duration events and queue accesses instant events, every ring is a thread
+ *
+ * @param   trace[in] Binary trace file to read
+ * @param   json[in] JSON file to write
+ *
+ * @retval  1 if the trace was converted, 0 if it is not a trace file
+ */
+uint8_t Trace_convert( FILE *trace, FILE *json )
+{
+    static const char *const names[] = { "tick", "tick", "task", "task", "timer", "timer", "queue write", "queue read" };
+    Trace_Header header;
+    Trace_Record record;
+    uint8_t exit = 0;
+    const char *separator = "";
+
+    if ( ( fread( &header, sizeof( header ), 1, trace ) == 1 ) && ( header.magic == TRACE_MAGIC ) && ( header.version == TRACE_VERSION ) && ( header.frequency != 0 ) )
+    {
+        fprintf( json, "{\"traceEvents\":[" );
+
+        while ( fread( &record, sizeof( record ), 1, trace ) == 1 )
+        {
+            double ts = ( (double)(int64_t)( record.time - header.base ) * 1e6 ) / (double)header.frequency;     // us
+
+            if ( record.event > TRACE_QUEUE_READ )
+            {
+                // Unknown event, skip it
+            }
+            else if ( record.event >= TRACE_QUEUE_WRITE )
+            {
+                fprintf( json, "%s\n{\"name\":\"%s\",\"cat\":\"queue\",\"ph\":\"i\",\"s\":\"t\",\"args\":{\"queue\":\"0x%08x\"}", separator, names[ record.event ], (unsigned)record.id );
+            }
+            else if ( record.event >= TRACE_TASK_BEGIN )
+            {
+                fprintf( json, "%s\n{\"name\":\"%s %u\",\"cat\":\"%s\",\"ph\":\"%c\"", separator, names[ record.event ], (unsigned)record.id, names[ record.event ], ( record.event & 1u ) ? 'E' : 'B' );
+            }
+            else
+            {
+                fprintf( json, "%s\n{\"name\":\"tick\",\"cat\":\"scheduler\",\"ph\":\"%c\",\"args\":{\"tick\":%u}", separator, ( record.event & 1u ) ? 'E' : 'B', (unsigned)record.id );
+            }
+
+            if ( record.event <= TRACE_QUEUE_READ )
+            {
+                fprintf( json, ",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", ts, (unsigned)record.thread );
+                separator = ",";
+            }
+        }
+
+        fprintf( json, "\n]}\n" );
+        exit = 1;
+    }
+
+    return exit;
+}
@@ -0,0 +1,73 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <stdatomic.h>
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+
+/* EVENTS */
+#define TRACE_TICK_BEGIN    0u      /*!< scheduler tick starts, id is the tick */
+#define TRACE_TICK_END      1u      /*!< scheduler tick ends, id is the tick */
+#define TRACE_TASK_BEGIN    2u      /*!< task run starts, id is the task slot */
+#define TRACE_TASK_END      3u      /*!< task run ends, id is the task slot */
+#define TRACE_TIMER_BEGIN   4u      /*!< timer callback starts, id is the timer slot */
+#define TRACE_TIMER_END     5u      /*!< timer callback ends, id is the timer slot */
+#define TRACE_QUEUE_WRITE   6u      /*!< queue written, id is the low bits of the queue address */
+#define TRACE_QUEUE_READ    7u      /*!< queue read, id is the low bits of the queue address */
+
+#define TRACE_MAGIC         0x43525453u     /*!< "STRC", first bytes of a trace file */
+#define TRACE_VERSION       1u              /*!< trace file format version */
+
+
+/**
+ * @brief Records an event on the ring of the calling thread, nothing if it has none
+*/
+#define TRACE_EVENT( event, id )    do { if ( Trace_currentRing != NULL ) { Trace_record( Trace_currentRing, event, id ); } } while ( 0 )
+
+
+/* STRUCTURES */
+typedef struct _Trace_Record
+{
+    uint64_t time;          /*!< timestamp counter value */
+    uint32_t id;            /*!< tick, task, timer or queue of the event */
+    uint8_t event;          /*!< TRACE_TICK_BEGIN ... TRACE_QUEUE_READ */
+    uint8_t thread;         /*!< thread number of the ring */
+    uint16_t reserved;      /*!< keeps the record 16 bytes long */
+} Trace_Record;
+
+
+typedef struct _Trace_Ring
+{
+    Trace_Record *buffer;   /*!< records, set by the user */
+    uint32_t size;          /*!< number of records, power of two, set by the user */
+    uint8_t thread;         /*!< thread number written on every record, set by the user */
+    atomic_uint head;       /*!< next record to write, only the owner thread moves it */
+    atomic_uint tail;       /*!< next record to read, only the reader moves it */
+    uint32_t dropped;       /*!< records lost because the ring was full */
+} Trace_Ring;
+
+
+typedef struct _Trace_Header
+{
+    uint32_t magic;         /*!< TRACE_MAGIC */
+    uint32_t version;       /*!< TRACE_VERSION */
+    uint64_t frequency;     /*!< timestamp counter ticks per second */
+    uint64_t base;          /*!< timestamp counter value of time 0 */
+} Trace_Header;
+
+
+extern _Thread_local Trace_Ring *Trace_currentRing;
+
+
+void Trace_initRing( Trace_Ring *ring );
+void Trace_bindRing( Trace_Ring *ring );
+void Trace_record( Trace_Ring *ring, uint8_t event, uint32_t id );
+uint8_t Trace_readRing( Trace_Ring *ring, Trace_Record *record );
+uint64_t Trace_now( void );
+void Trace_writeHeader( FILE *file );
+uint32_t Trace_writeRing( Trace_Ring *ring, FILE *file );
+uint8_t Trace_convert( FILE *trace, FILE *json );
+
+
+#endif
@@ -0,0 +1,39 @@
+#include <stdio.h>
+#include "trace.h"
+
+
+/**
+ * @brief   Converts a binary scheduler trace to Chrome trace event JSON
+ *
+ * Usage: trace2json trace.bin trace.json
+*/
+int main( int argc, char *argv[] )
+{
+    FILE *trace;
+    FILE *json;
+    int exit = 1;
+
+    if ( argc != 3 )
+    {
+        fprintf( stderr, "usage: %s trace.bin trace.json\n", argv[ 0 ] );
+        return 1;
+    }
+
+    trace = fopen( argv[ 1 ], "rb" );
+    json = fopen( argv[ 2 ], "w" );
+
+    if ( ( trace != NULL ) && ( json != NULL ) )
+    {
+        exit = ( Trace_convert( trace, json ) == 0 );
+    }
+
+    if ( exit )
+    {
+        fprintf( stderr, "%s: can not convert %s\n", argv[ 0 ], argv[ 1 ] );
+    }
+
+    if ( trace != NULL ) fclose( trace );
+    if ( json != NULL ) fclose( json );
+
+    return exit;
+}
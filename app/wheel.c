@@ -0,0 +1,360 @@
+/**
+ * @file    wheel.c
+ * @brief   Timing wheel's source code
+ *
+ * This is a hierarchical timing wheel. Every level has WHEEL_SLOTS slots, level 0 resolves
+ * single ticks and every upper level resolves WHEEL_SLOTS times the ticks of the level below.
+ * Nodes are linked in the slot of the lowest level that can hold their expiry and they are
+ * cascaded to the lower levels when the wheel reaches their slot, so inserting, removing and
+ * expiring a node is O(1)
+ */
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "wheel.h"
+
+
+/**
+  * @defgroup WHEEL MACROS brief wheel helpers
+  @{ */
+#define WHEEL_MASK          ( WHEEL_SLOTS - 1u )                            /*!< slot index mask */
+#define WHEEL_RANGE         ( 1ul << ( WHEEL_LEVELS * WHEEL_BITS ) )        /*!< ticks covered by the whole wheel */
+#define WHEEL_SHIFT( l )    ( ( l ) * WHEEL_BITS )                          /*!< tick shift of level l */
+#define WHEEL_EXPIRED       WHEEL_LEVELS                                    /*!< level of the nodes on the expired list */
+/**
+  @} */
+
+
+/**
+ * @brief   Link node function
+ *
+ * Links a node at the head of a list
+ *
+ * @param   head[in] Pointer to the list head
+ * @param   node[in] Pointer to the node to link
+ *
+ * @retval  None
+ */
+static void Wheel_link( Wheel_Node **head, Wheel_Node *node )
+{
+    node->next = *head;
+
+    if ( *head != NULL )
+    {
+        ( *head )->pprev = &node->next;
+    }
+
+    *head = node;
+    node->pprev = head;
+}
+
+
+/**
+ * @brief   Rotate bitmap function
+ *
+ * Rotates a slot bitmap so that bit 0 corresponds to the given slot
+ *
+ * @param   bitmap[in] Slot bitmap of a level
+ * @param   slot[in] Slot to move to bit 0
+ *
+ * @retval  The rotated bitmap
+ */
+static uint64_t Wheel_rotate( uint64_t bitmap, uint32_t slot )
+{
+    return ( slot == 0 ) ? bitmap : ( ( bitmap >> slot ) | ( bitmap << ( WHEEL_SLOTS - slot ) ) );
+}
+
+
+/**
+ * @brief   Cascade function
+ *
+ * Re-inserts every node of a slot so it moves to the lower levels
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ * @param   level[in] Level of the slot
+ * @param   slot[in] Slot to cascade
+ *
+ * @retval  None
+ */
+static void Wheel_cascade( Wheel *wheel, uint32_t level, uint32_t slot )
+{
+    Wheel_Node *node = wheel->slots[ level ][ slot ];
+
+    wheel->slots[ level ][ slot ] = NULL;
+    wheel->bitmap[ level ] &= ~( 1ull << slot );
+
+    while ( node != NULL )
+    {
+        Wheel_Node *next = node->next;
+
+        Wheel_insert( wheel, node, node->expiry );
+        node = next;
+    }
+}
+
+
+/**
+ * @brief   Init wheel function
+ *
+ * Initializes an empty wheel
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ * @param   now[in] First tick the wheel will process
+ *
+ * @retval  None
+ */
+void Wheel_initWheel( Wheel *wheel, uint32_t now )
+{
+    wheel->now = now;
+    wheel->expired = NULL;
+
+    for ( uint32_t level = 0; level < WHEEL_LEVELS; level++ )
+    {
+        wheel->bitmap[ level ] = 0;
+
+        for ( uint32_t slot = 0; slot < WHEEL_SLOTS; slot++ )
+        {
+            wheel->slots[ level ][ slot ] = NULL;
+        }
+    }
+}
+
+
+/**
+ * @brief   Init node function
+ *
+ * Initializes a node as not linked to any wheel
+ *
+ * @param   node[in] Pointer to a Wheel_Node variable
+ *
+ * @retval  None
+ */
+void Wheel_initNode( Wheel_Node *node )
+{
+    node->next = NULL;
+    node->pprev = NULL;
+}
+
+
+/**
+ * @brief   Is linked function
+ *
+ * Tells if a node is pending on a wheel
+ *
+ * @param   node[in] Pointer to a Wheel_Node variable
+ *
+ * @retval  1 if the node is linked, 0 otherwise
+ */
+uint8_t Wheel_isLinked( Wheel_Node *node )
+{
+    return node->pprev != NULL;
+}
+
+
+/**
+ * @brief   Insert function
+ *
+ * Links a node to expire on the given tick, the node must not be linked. Expiries already
+ * behind the wheel expire on the next processed tick and expiries further than the wheel
+ * range are parked on the last level until they get closer
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ * @param   node[in] Pointer to the node to insert
+ * @param   expiry[in] Absolute tick when the node has to expire
+ *
+ * @retval  None
+ */
+void Wheel_insert( Wheel *wheel, Wheel_Node *node, uint32_t expiry )
+{
+    uint32_t delta = expiry - wheel->now;
+    uint32_t position = expiry;
+    uint32_t level = 0;
+
+    if ( (int32_t)delta < 0 )
+    {
+        delta = 0;                                      // Already late, expire on the next tick
+        position = wheel->now;
+    }
+    else if ( delta >= WHEEL_RANGE )
+    {
+        delta = WHEEL_RANGE - 1u;                       // Too far, park it on the last level
+        position = wheel->now + delta;
+    }
+
+    while ( delta >= ( 1ul << WHEEL_SHIFT( level + 1u ) ) )
+    {
+        level++;
+    }
+
+    node->expiry = expiry;
+    node->level = level;
+    node->slot = ( position >> WHEEL_SHIFT( level ) ) & WHEEL_MASK;
+
+    Wheel_link( &wheel->slots[ level ][ node->slot ], node );
+    wheel->bitmap[ level ] |= 1ull << node->slot;
+}
+
+
+/**
+ * @brief   Remove function
+ *
+ * Unlinks a node from the wheel or from the expired list, nothing is done if the node is
+ * not linked
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ * @param   node[in] Pointer to the node to remove
+ *
+ * @retval  None
+ */
+void Wheel_remove( Wheel *wheel, Wheel_Node *node )
+{
+    if ( node->pprev != NULL )
+    {
+        *node->pprev = node->next;
+
+        if ( node->next != NULL )
+        {
+            node->next->pprev = node->pprev;
+        }
+
+        if ( ( node->level != WHEEL_EXPIRED ) && ( wheel->slots[ node->level ][ node->slot ] == NULL ) )
+        {
+            wheel->bitmap[ node->level ] &= ~( 1ull << node->slot );     // Slot is empty now
+        }
+
+        node->next = NULL;
+        node->pprev = NULL;
+    }
+}
+
+
+/**
+ * @brief   Advance function
+ *
+ * Processes the next tick of the wheel, upper levels are cascaded when the lower level
+ * wraps and the nodes expiring on this tick are moved to the expired list
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ *
+ * @retval  None
+ */
+void Wheel_advance( Wheel *wheel )
+{
+    uint32_t now = wheel->now;
+    uint32_t slot = now & WHEEL_MASK;
+    uint32_t top = 0;
+
+    while ( ( top + 1u < WHEEL_LEVELS ) && ( ( now & ( ( 1ul << WHEEL_SHIFT( top + 1u ) ) - 1u ) ) == 0 ) )
+    {
+        top++;                                          // Every level below top + 1 wrapped
+    }
+
+    for ( uint32_t level = top; level > 0; level-- )
+    {
+        Wheel_cascade( wheel, level, ( now >> WHEEL_SHIFT( level ) ) & WHEEL_MASK );
+    }
+
+    wheel->expired = wheel->slots[ 0 ][ slot ];
+    wheel->slots[ 0 ][ slot ] = NULL;
+    wheel->bitmap[ 0 ] &= ~( 1ull << slot );
+
+    if ( wheel->expired != NULL )
+    {
+        wheel->expired->pprev = &wheel->expired;
+    }
+
+    for ( Wheel_Node *node = wheel->expired; node != NULL; node = node->next )
+    {
+        node->level = WHEEL_EXPIRED;
+    }
+
+    wheel->now++;
+}
+
+
+/**
+ * @brief   Pop expired function
+ *
+ * Takes the next node from the list of nodes expired by the last Wheel_advance call
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ *
+ * @retval  Pointer to the expired node, NULL when there are no more expired nodes
+ */
+Wheel_Node *Wheel_popExpired( Wheel *wheel )
+{
+    Wheel_Node *node = wheel->expired;
+
+    if ( node != NULL )
+    {
+        Wheel_remove( wheel, node );
+    }
+
+    return node;
+}
+
+
+/**
+ * @brief   Next event function
+ *
+ * Computes the number of ticks from the next tick to be processed until a tick that has
+ * to expire or cascade a slot. The ticks in between can be skipped with Wheel_skip
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ * @param   limit[in] Maximum value to return
+ *
+ * @retval  Ticks until the next event, 0 if the next tick has work, limit if there is nothing sooner
+ */
+uint32_t Wheel_nextEvent( Wheel *wheel, uint32_t limit )
+{
+    uint32_t next = limit;
+
+    for ( uint32_t level = 0; level < WHEEL_LEVELS; level++ )
+    {
+        if ( wheel->bitmap[ level ] != 0 )
+        {
+            uint32_t shift = WHEEL_SHIFT( level );
+            uint32_t base = wheel->now >> shift;
+            uint64_t bits = Wheel_rotate( wheel->bitmap[ level ], base & WHEEL_MASK );
+            uint32_t offset;
+            uint32_t ticks;
+
+            if ( ( level > 0 ) && ( ( wheel->now & ( ( 1ul << shift ) - 1u ) ) != 0 ) )
+            {
+                // Current slot of an upper level was already cascaded, its nodes belong to the next turn
+                offset = ( ( bits & ~1ull ) != 0 ) ? (uint32_t)__builtin_ctzll( bits & ~1ull ) : WHEEL_SLOTS;
+            }
+            else
+            {
+                offset = (uint32_t)__builtin_ctzll( bits );
+            }
+
+            ticks = ( ( base + offset ) << shift ) - wheel->now;
+
+            if ( ticks < next )
+            {
+                next = ticks;
+            }
+        }
+    }
+
+    return next;
+}
+
+
+/**
+ * @brief   Skip function
+ *
+ * Moves the wheel forward without processing the ticks, only valid for a number of ticks
+ * not bigger than the returned by Wheel_nextEvent
+ *
+ * @param   wheel[in] Pointer to a Wheel variable
+ * @param   ticks[in] Number of ticks to skip
+ *
+ * @retval  None
+ */
+void Wheel_skip( Wheel *wheel, uint32_t ticks )
+{
+    wheel->now += ticks;
+}
@@ -0,0 +1,43 @@
+#include <stdint.h>
+
+#ifndef WHEEL_H_
+#define WHEEL_H_
+
+
+#define WHEEL_LEVELS    4u      /*!< number of wheel levels */
+#define WHEEL_BITS      6u      /*!< bits of tick resolved by every level */
+#define WHEEL_SLOTS     64u     /*!< slots on every level, 1 << WHEEL_BITS */
+
+
+/* STRUCTURES */
+typedef struct _Wheel_Node
+{
+    struct _Wheel_Node *next;       /*!< next node in the same slot */
+    struct _Wheel_Node **pprev;     /*!< pointer to the previous next pointer, NULL when not linked */
+    uint32_t expiry;                /*!< absolute tick when the node expires */
+    uint8_t level;                  /*!< wheel level the node is linked in */
+    uint8_t slot;                   /*!< slot of the level the node is linked in */
+} Wheel_Node;
+
+
+typedef struct _Wheel
+{
+    uint32_t now;                                       /*!< next tick to be processed */
+    uint64_t bitmap[ WHEEL_LEVELS ];                    /*!< occupied slots of every level */
+    Wheel_Node *slots[ WHEEL_LEVELS ][ WHEEL_SLOTS ];   /*!< list heads of every slot */
+    Wheel_Node *expired;                                /*!< nodes expired on the last processed tick */
+} Wheel;
+
+
+void Wheel_initWheel( Wheel *wheel, uint32_t now );
+void Wheel_initNode( Wheel_Node *node );
+uint8_t Wheel_isLinked( Wheel_Node *node );
+void Wheel_insert( Wheel *wheel, Wheel_Node *node, uint32_t expiry );
+void Wheel_remove( Wheel *wheel, Wheel_Node *node );
+void Wheel_advance( Wheel *wheel );
+Wheel_Node *Wheel_popExpired( Wheel *wheel );
+uint32_t Wheel_nextEvent( Wheel *wheel, uint32_t limit );
+void Wheel_skip( Wheel *wheel, uint32_t ticks );
+
+
+#endif
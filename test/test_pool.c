@@ -0,0 +1,138 @@
+#include <stdatomic.h>
+#include "unity.h"
+#include "pool.h"
+
+#define TRUE    1
+#define FALSE   0
+
+#define JOBS_N      64
+
+static Pool pool;
+static Pool_Job jobs[ JOBS_N ];
+static atomic_uint runs;
+static atomic_uchar pinnedWorker;
+static atomic_uint gate;
+
+
+void countJob(void);
+void pinnedJob(void);
+void gateJob(void);
+
+void setUp(void)
+{
+    atomic_store( &runs, 0 );
+    atomic_store( &gate, 0 );
+}
+
+void tearDown(void)
+{
+}
+
+
+/**
+ * @brief   Test init pool function
+ *
+ * The test verifies that the number of workers is checked
+ */
+void test__Pool_initPool( void )
+{
+    TEST_ASSERT_EQUAL( FALSE, Pool_initPool( &pool, 0 ) );
+    TEST_ASSERT_EQUAL( FALSE, Pool_initPool( &pool, POOL_WORKERS_MAX + 1 ) );
+    TEST_ASSERT_EQUAL( TRUE, Pool_initPool( &pool, 4 ) );
+    TEST_ASSERT_EQUAL( 4, pool.workers );
+    TEST_ASSERT_EQUAL( POOL_ANY_WORKER, Pool_currentWorker() );
+
+    Pool_stopPool( &pool );
+}
+
+
+/**
+ * @brief   Test submit and wait functions
+ *
+ * The test submits many jobs and verifies that every one of them runs once
+ */
+void test__Pool_submitAll( void )
+{
+    Pool_initPool( &pool, 4 );
+
+    for ( uint32_t i = 0; i < JOBS_N; i++ )
+    {
+        Pool_initJob( &jobs[ i ], countJob );
+        TEST_ASSERT_EQUAL( TRUE, Pool_submit( &pool, &jobs[ i ] ) );
+    }
+
+    Pool_wait( &pool );
+
+    TEST_ASSERT_EQUAL( JOBS_N, atomic_load( &runs ) );
+
+    Pool_stopPool( &pool );
+}
+
+
+/**
+ * @brief   Test no self overlap
+ *
+ * The test verifies that a job can not be submitted again while it is still running
+ */
+void test__Pool_noOverlap( void )
+{
+    Pool_initPool( &pool, 4 );
+    Pool_initJob( &jobs[ 0 ], gateJob );
+
+    TEST_ASSERT_EQUAL( TRUE, Pool_submit( &pool, &jobs[ 0 ] ) );
+    TEST_ASSERT_EQUAL( FALSE, Pool_submit( &pool, &jobs[ 0 ] ) );
+
+    atomic_store( &gate, 1 );
+    Pool_wait( &pool );
+
+    TEST_ASSERT_EQUAL( TRUE, Pool_submit( &pool, &jobs[ 0 ] ) );
+
+    Pool_wait( &pool );
+
+    TEST_ASSERT_EQUAL( 2, atomic_load( &runs ) );
+
+    Pool_stopPool( &pool );
+}
+
+
+/**
+ * @brief   Test pinned jobs
+ *
+ * The test verifies that a pinned job always runs on its worker
+ */
+void test__Pool_pinnedJob( void )
+{
+    Pool_initPool( &pool, 4 );
+    Pool_initJob( &jobs[ 0 ], pinnedJob );
+    jobs[ 0 ].worker = 2;
+
+    for ( uint32_t i = 0; i < 20; i++ )
+    {
+        atomic_store( &pinnedWorker, POOL_ANY_WORKER );
+
+        Pool_submit( &pool, &jobs[ 0 ] );
+        Pool_wait( &pool );
+
+        TEST_ASSERT_EQUAL( 2, atomic_load( &pinnedWorker ) );
+    }
+
+    Pool_stopPool( &pool );
+}
+
+
+void countJob(void)
+{
+    atomic_fetch_add( &runs, 1 );
+}
+
+void pinnedJob(void)
+{
+    atomic_store( &pinnedWorker, Pool_currentWorker() );
+}
+
+void gateJob(void)
+{
+    while ( atomic_load( &gate ) == 0 ) {}
+
+    atomic_fetch_add( &runs, 1 );
+}
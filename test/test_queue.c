@@ -1,5 +1,6 @@
 #include "unity.h"
 #include "queue.h"
+#include "trace.h"
 
 #define TRUE    1
 #define FALSE   0
@@ -420,3 +421,44 @@ void test__Queue_readSomeData()
     printf("Read some data test succeed");
 }
 
+
+
+static uint8_t notified = 0;
+
+void notifyFun( void *listener )
+{
+    notified += *(uint8_t *)listener;
+}
+
+
+/**
+ * @brief Listener test
+ * 
+ * This test verify if the listener is called on every write and kept by a flush
+*/
+void test__Queue_listener()
+{
+    uint8_t dato = 0xFF;
+    uint8_t step = 1;
+    Queue_initQueue( &queue );
+    queue.Elements = 5u;
+    uint8_t array[queue.Elements];
+    queue.Buffer = &array;
+    queue.Size = sizeof( dato );
+    notified = 0;
+
+    Queue_setListener( &queue, notifyFun, &step );
+    Queue_writeData( &queue, &dato );
+    Queue_writeData( &queue, &dato );
+    Queue_readData( &queue, &array );
+    Queue_flushQueue( &queue );
+    Queue_writeData( &queue, &dato );
+
+    TEST_ASSERT_EQUAL( 3, notified );
+
+    Queue_initQueue( &queue );
+    Queue_writeData( &queue, &dato );
+
+    TEST_ASSERT_EQUAL( 3, notified );
+    printf("Listener test succeed");
+}
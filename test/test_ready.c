@@ -0,0 +1,143 @@
+#include "unity.h"
+#include "ready.h"
+
+#define TRUE    1
+#define FALSE   0
+
+#define NODES_N     32
+
+static Ready_Queue queue;
+static Ready_Node nodes[ NODES_N ];
+
+
+void setUp(void)
+{
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        Ready_initNode( &nodes[ i ] );
+    }
+}
+
+void tearDown(void)
+{
+}
+
+
+/**
+ * @brief   Test FIFO policy
+ *
+ * The test verifies that nodes are taken in the same order they were pushed
+ */
+void test__Ready_fifoOrder( void )
+{
+    Ready_initQueue( &queue, READY_FIFO );
+
+    TEST_ASSERT_EQUAL( TRUE, Ready_isQueueEmpty( &queue ) );
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        Ready_push( &queue, &nodes[ i ], NODES_N - i );
+    }
+
+    TEST_ASSERT_EQUAL( NODES_N, queue.count );
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        Ready_Node *node = Ready_pop( &queue );
+
+        TEST_ASSERT_EQUAL_PTR( &nodes[ i ], node );
+        TEST_ASSERT_EQUAL( FALSE, node->queued );
+    }
+
+    TEST_ASSERT_EQUAL_PTR( NULL, Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL( TRUE, Ready_isQueueEmpty( &queue ) );
+}
+
+
+/**
+ * @brief   Test EDF policy
+ *
+ * The test pushes nodes with scrambled deadlines and verifies that they are taken by earliest
+ * deadline, with equal deadlines taken in push order
+ */
+void test__Ready_edfOrder( void )
+{
+    uint32_t lastKey = 0;
+    uint32_t lastIndex = 0;
+
+    Ready_initQueue( &queue, READY_EDF );
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        Ready_push( &queue, &nodes[ i ], ( i * 7u ) % 11u );
+    }
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        Ready_Node *node = Ready_pop( &queue );
+        uint32_t index = node - nodes;
+
+        TEST_ASSERT_EQUAL( ( index * 7u ) % 11u, node->key );
+        TEST_ASSERT_GREATER_OR_EQUAL( lastKey, node->key );
+
+        if ( ( i > 0 ) && ( node->key == lastKey ) )
+        {
+            TEST_ASSERT_GREATER_THAN( lastIndex, index );
+        }
+
+        lastKey = node->key;
+        lastIndex = index;
+    }
+
+    TEST_ASSERT_EQUAL( TRUE, Ready_isQueueEmpty( &queue ) );
+}
+
+
+/**
+ * @brief   Test EDF deadlines with wrap around
+ *
+ * The test verifies that deadlines after the 32 bit wrap go after the ones before it
+ */
+void test__Ready_edfWrapAround( void )
+{
+    Ready_initQueue( &queue, READY_EDF );
+
+    Ready_push( &queue, &nodes[ 0 ], 5u );
+    Ready_push( &queue, &nodes[ 1 ], 0xFFFFFFF0u );
+    Ready_push( &queue, &nodes[ 2 ], 0xFFFFFFFFu );
+
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 1 ], Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 2 ], Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 0 ], Ready_pop( &queue ) );
+}
+
+
+/**
+ * @brief   Test priority policy
+ *
+ * The test verifies that nodes are taken by highest priority and in push order within the
+ * same priority level
+ */
+void test__Ready_priorityOrder( void )
+{
+    Ready_initQueue( &queue, READY_PRIORITY );
+
+    Ready_push( &queue, &nodes[ 0 ], 63u );
+    Ready_push( &queue, &nodes[ 1 ], 5u );
+    Ready_push( &queue, &nodes[ 2 ], 0u );
+    Ready_push( &queue, &nodes[ 3 ], 5u );
+    Ready_push( &queue, &nodes[ 4 ], 32u );
+
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 2 ], Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 1 ], Ready_pop( &queue ) );
+
+    Ready_push( &queue, &nodes[ 5 ], 1u );
+
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 5 ], Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 3 ], Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 4 ], Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 0 ], Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, Ready_pop( &queue ) );
+    TEST_ASSERT_EQUAL( TRUE, Ready_isQueueEmpty( &queue ) );
+    TEST_ASSERT_EQUAL( 0, queue.bitmap );
+}
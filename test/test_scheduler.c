@@ -1,6 +1,15 @@
 #include <assert.h>
+#include <time.h>
+#include <pthread.h>
+#include <unistd.h>
 #include "unity.h"
 #include "scheduler.h"
+#include "queue.h"
+#include "wheel.h"
+#include "ready.h"
+#include "pool.h"
+#include "stats.h"
+#include "trace.h"
 
 
 #define TRUE 1
@@ -9,28 +18,108 @@
 #define TASKS_N     12
 #define TIMERS_N    12
 #define TICK_VAL    100
+#define COROS_N     1
+#define SOURCES_N   2
 
 static Sched_Task tasks[ TASKS_N ];
 static Sched_Scheduler Sche;
 static Sched_Timer timers[ TIMERS_N ];
 static uint8_t count = 0;
+static uint8_t runOrder[ TASKS_N ];
+static uint8_t stalled = 0;
+static Que_Queue eventQueue;
+static uint8_t eventBuffer[ 8 ];
+static uint64_t writeTime;
+static uint64_t readTime;
+static Sched_Coro coros[ COROS_N ];
+static uint32_t coroTimer;
+static Sched_Source sources[ SOURCES_N ];
+static int pipeFds[ 2 ];
+static uint32_t readTicks[ 4 ];
+static uint32_t expirations;
+static Trace_Ring traceRing;
+static Trace_Record traceRecords[ 64 ];
+static uint32_t idles;
+static uint32_t overruns;
+static uint32_t firedTicks[ 8 ];
+static uint32_t overrunHandle;
+static uint8_t overrunRunning;
+static atomic_uchar busyRunning;
+typedef struct { uint32_t resumed[ 4 ]; uint8_t data; } CoroFrame;
+static CoroFrame coroFrames[ COROS_N ];
 
 
 void fun1(void);
 void fun2(void);
+void countFun(void);
+void orderFun1(void);
+void orderFun2(void);
+void orderFun3(void);
+void slowFun(void);
+void stallFun(void);
+void producerFun(void);
+void consumerFun(void);
+void coroFun( Sched_Coro *coro );
+void coroListenFun( Sched_Coro *coro );
+void pipeWriteFun(void);
+void pipeReadFun( int fd, uint8_t events );
+void expiredFun( uint32_t missed );
+void halfTickFun(void);
+void idleFun(void);
+void busyFun(void);
+void slackFun( uint32_t missed );
+void overrunFun( uint32_t task );
+void tableInit(void);
+void tableFun1(void);
+void tableFun2(void);
+void tickFun(void);
+void budgetFun(void);
+
+static uint8_t tableInits;
+static uint8_t tickRuns[ 13 ];
+static uint32_t frameBuffer[ 16 ];
+static uint32_t budgetHandle;
+static uint8_t budgetRuns;
+static uint8_t tableRuns[ 2 ];
+
+#define TABLE_NAME      testTable
+#define TABLE_TICK      SCHED_MS( TICK_VAL )
+#define TABLE_TASKS( TASK ) \
+    TASK( tableInit, tableFun1, SCHED_MS( 200 ) ) \
+    TASK( tableInit, tableFun2, SCHED_MS( 300 ) )
+#include "table.h"
 
 void setUp(void)
 {
-    Sche.tick = TICK_VAL;
+    Sche.tick = 0;
+    Sche.tickUs = SCHED_MS( TICK_VAL );
     Sche.tasks = TASKS_N;
-    Sche.timeout = 500;
+    Sche.timeout = 0;
+    Sche.timeoutUs = SCHED_MS( 500 );
     Sche.taskPtr = tasks;
     Sche.timers = TIMERS_N;
     Sche.timerPtr = timers;
+    Sche.tickless = FALSE;
+    Sche.policy = SCHED_POLICY_FIFO;
+    Sche.pool = NULL;
+    Sche.coros = COROS_N;
+    Sche.coroPtr = coros;
+    Sche.frameArena = coroFrames;
+    Sche.frameSize = sizeof( CoroFrame );
+    Sche.sources = SOURCES_N;
+    Sche.sourcePtr = sources;
+    Sche.simulated = FALSE;
+    Sche.trace = NULL;
+    Sche.idlePtr = NULL;
+    Sche.watchdog = 0;
+    Sche.watchdogUs = 0;
+    Sche.realtime = FALSE;
+    Sche.cyclic = FALSE;
 }
 
 void tearDown(void)
 {
+    Sched_deinitScheduler( &Sche );
 }
 
 
@@ -58,17 +147,17 @@ void test__stopTask(void)
 {
     Sched_initScheduler( &Sche );
 
-    Sched_registerTask( &Sche, fun1, fun2, 500 );
+    Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 500 ) );
 
     Sched_startScheduler( &Sche );
 
-    uint32_t elapedBeforeStop = Sche.taskPtr[0].elapsed;
+    Sched_Time elapedBeforeStop = Sche.taskPtr[0].elapsed;
 
     Sched_stopTask( &Sche, 1 );
 
     Sched_startScheduler( &Sche );
 
-    uint32_t elapedAftertop = Sche.taskPtr[0].elapsed;
+    Sched_Time elapedAftertop = Sche.taskPtr[0].elapsed;
 
     TEST_ASSERT_EQUAL( elapedBeforeStop, elapedAftertop );
 
@@ -103,14 +192,14 @@ void test__stopNonExistingTask(void)
 */
 void test__stopMultipleTasks(void)
 {
-    uint32_t elapsedBeforeStop[2];
-    uint32_t elapsedAfterStop[5];
+    Sched_Time elapsedBeforeStop[2];
+    Sched_Time elapsedAfterStop[5];
 
     Sched_initScheduler( &Sche );
 
-    Sched_registerTask( &Sche, fun1, fun2, 200 );
-    Sched_registerTask( &Sche, fun1, fun2, 200 );
-    Sched_registerTask( &Sche, fun1, fun2, 200 );
+    Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 200 ) );
 
     /* Getting elapsed time of taks 1 and 3 */
     elapsedBeforeStop[ 0 ] = Sche.taskPtr[0].elapsed;
@@ -149,20 +238,20 @@ void test__stopTimer(void)
 {
     Sched_initScheduler( &Sche );
 
-    Sched_registerTimer( &Sche, 200, fun1 );
+    Sched_registerTimerUs( &Sche, SCHED_MS( 200 ), fun1 );
 
     Sched_startTimer( &Sche, 1 );
 
     Sched_startScheduler( &Sche );
 
-    uint32_t countBeforeStop = Sche.timerPtr[0].count;     // Takes de final value of count
+    Sched_Time countBeforeStop = Sche.timerPtr[0].count;     // Takes de final value of count
 
     Sched_stopTimer( &Sche, 1 );        // Stop timer
-    Sched_reloadTimer( &Sche, 1, 300);       // Reloads it's value
+    Sched_reloadTimerUs( &Sche, 1, SCHED_MS( 300 ));       // Reloads it's value
 
     Sched_startScheduler( &Sche );
 
-    uint32_t countAftertop = Sche.timerPtr[0].count;
+    Sched_Time countAftertop = Sche.timerPtr[0].count;
 
     uint8_t res = Sched_stopTimer( &Sche, 0 );
     uint8_t res2 = Sched_stopTimer( &Sche, 99 );
@@ -182,14 +271,14 @@ void test__stopTimer(void)
 */
 void test__stopMultipleTimers(void)
 {
-    uint32_t countBeforeStop[5];
-    uint32_t countAfterStop[5];
+    Sched_Time countBeforeStop[5];
+    Sched_Time countAfterStop[5];
 
     Sched_initScheduler( &Sche );
 
-    Sched_registerTimer( &Sche, 200, fun1 );
-    Sched_registerTimer( &Sche, 200, fun1 );
-    Sched_registerTimer( &Sche, 200, fun1 );
+    Sched_registerTimerUs( &Sche, SCHED_MS( 200 ), fun1 );
+    Sched_registerTimerUs( &Sche, SCHED_MS( 200 ), fun1 );
+    Sched_registerTimerUs( &Sche, SCHED_MS( 200 ), fun1 );
 
     Sched_startTimer( &Sche, 1 );
     Sched_startTimer( &Sche, 2 );
@@ -202,9 +291,9 @@ void test__stopMultipleTimers(void)
     countBeforeStop[ 1 ] = Sche.timerPtr[2].count;
 
     Sched_stopTimer( &Sche, 1 );
-    Sched_reloadTimer( &Sche, 1, 300);
+    Sched_reloadTimerUs( &Sche, 1, SCHED_MS( 300 ));
     Sched_stopTimer( &Sche, 3 );
-    Sched_reloadTimer( &Sche, 3, 300);
+    Sched_reloadTimerUs( &Sche, 3, SCHED_MS( 300 ));
 
         
     Sched_startScheduler( &Sche );
@@ -228,23 +317,23 @@ void test__stopMultipleTimers(void)
 */
 void test__reloadTimer(void)
 {
-    uint16_t reloadTime = 900;
+    Sched_Time reloadTime = SCHED_MS( 900 );
 
     Sched_initScheduler( &Sche );
 
     Sched_initScheduler( &Sche );
 
-    Sched_registerTimer( &Sche, 200, fun1 );
+    Sched_registerTimerUs( &Sche, SCHED_MS( 200 ), fun1 );
 
     Sched_startTimer( &Sche, 1);
 
     Sched_startScheduler( &Sche );
 
-    uint8_t res = Sched_reloadTimer( &Sche, 1, reloadTime );
-    uint8_t res2 = Sched_reloadTimer( &Sche , 1, 1550 );
-    uint8_t res3 = Sched_reloadTimer( &Sche , 0, 1000 );
-    uint8_t res4 = Sched_reloadTimer( &Sche , 1, 0 );
-    uint8_t res5 = Sched_reloadTimer( &Sche , 99, 0 );
+    uint8_t res = Sched_reloadTimerUs( &Sche, 1, reloadTime );
+    uint8_t res2 = Sched_reloadTimerUs( &Sche , 1, SCHED_MS( 1550 ) );
+    uint8_t res3 = Sched_reloadTimerUs( &Sche , 0, SCHED_MS( 1000 ) );
+    uint8_t res4 = Sched_reloadTimerUs( &Sche , 1, 0 );
+    uint8_t res5 = Sched_reloadTimerUs( &Sche , 99, 0 );
 
     TEST_ASSERT_EQUAL( reloadTime, Sche.timerPtr->timeout );
     TEST_ASSERT_EQUAL(TRUE, res);
@@ -264,10 +353,10 @@ void test__registerTask(void)
 {
     Sched_initScheduler( &Sche );
 
-    uint8_t res = Sched_registerTask( &Sche, fun1, fun2, 50 );
-    uint8_t res2 = Sched_registerTask( &Sche, fun1, fun2, 200 );
-    uint8_t res3 = Sched_registerTask( &Sche, fun1, NULL, 200 );
-    uint8_t res4 = Sched_registerTask( &Sche, fun1, NULL, 120 );
+    uint8_t res = Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 50 ) );
+    uint8_t res2 = Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 200 ) );
+    uint8_t res3 = Sched_registerTaskUs( &Sche, fun1, NULL, SCHED_MS( 200 ) );
+    uint8_t res4 = Sched_registerTaskUs( &Sche, fun1, NULL, SCHED_MS( 120 ) );
 
     TEST_ASSERT_EQUAL( FALSE, res );
     TEST_ASSERT_EQUAL( TRUE, res2 );
@@ -303,10 +392,10 @@ void test__periodTask(void)
 {
     Sched_initScheduler( &Sche );
 
-    uint8_t res = Sched_periodTask( &Sche , 0, 100 );
-    uint8_t res2 = Sched_periodTask( &Sche , 1, 50 );
-    uint8_t res3 = Sched_periodTask( &Sche , 1, 100 );
-    uint8_t res4 = Sched_periodTask( &Sche , 99, 100 );
+    uint8_t res = Sched_periodTaskUs( &Sche , 0, SCHED_MS( 100 ) );
+    uint8_t res2 = Sched_periodTaskUs( &Sche , 1, SCHED_MS( 50 ) );
+    uint8_t res3 = Sched_periodTaskUs( &Sche , 1, SCHED_MS( 100 ) );
+    uint8_t res4 = Sched_periodTaskUs( &Sche , 99, SCHED_MS( 100 ) );
 
     TEST_ASSERT_EQUAL( FALSE, res );
     TEST_ASSERT_EQUAL( FALSE, res2 );
@@ -324,8 +413,8 @@ void test__registerTimer(void)
 {
     Sched_initScheduler( &Sche );
 
-    uint8_t res = Sched_registerTimer( &Sche , 50, fun1 );
-    uint8_t res2 = Sched_registerTimer( &Sche, 0, fun1 );
+    uint8_t res = Sched_registerTimerUs( &Sche , SCHED_MS( 50 ), fun1 );
+    uint8_t res2 = Sched_registerTimerUs( &Sche, 0, fun1 );
 
     TEST_ASSERT_EQUAL(0, res);
     TEST_ASSERT_EQUAL(0, res2);
@@ -341,9 +430,9 @@ void test__getTimer(void)
 {
     Sched_initScheduler( &Sche );
 
-    uint32_t res = Sched_getTimer( &Sche , 0 );
-    uint32_t res2 = Sched_getTimer( &Sche, 1 );
-    uint32_t res3 = Sched_getTimer( &Sche, 13 );
+    Sched_Time res = Sched_getTimerUs( &Sche , 0 );
+    Sched_Time res2 = Sched_getTimerUs( &Sche, 1 );
+    Sched_Time res3 = Sched_getTimerUs( &Sche, 13 );
 
     TEST_ASSERT_EQUAL(FALSE, res);
     TEST_ASSERT_EQUAL( Sche.timerPtr[0].count, res2 );
@@ -397,6 +486,1320 @@ void test__startTask(void)
 
 
 
+/**
+ * @brief Test tickless scheduler
+ * 
+ * This test runs the same tasks and timers in tick and tickless mode and verifies that both
+ * modes end with the same elapsed times, timer counts and number of task executions
+*/
+void test__ticklessScheduler(void)
+{
+    Sched_Time elapsed[2];
+    Sched_Time timerCount[2];
+    uint8_t runs[2];
+    uint64_t wakeups[2];
+    uint8_t timer;
+
+    for ( uint8_t mode = 0; mode < 2; mode++ )
+    {
+        Sche.tickless = mode;
+        count = 0;
+
+        Sched_initScheduler( &Sche );
+
+        Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 200 ) );
+        timer = Sched_registerTimerUs( &Sche, SCHED_MS( 300 ), fun1 );
+        Sched_startTimer( &Sche, timer );
+
+        Sched_startScheduler( &Sche );
+
+        elapsed[ mode ] = Sche.taskPtr[0].elapsed;
+        timerCount[ mode ] = Sche.timerPtr[ timer - 1 ].count;
+        runs[ mode ] = count;
+        wakeups[ mode ] = Sched_wakeupsScheduler( &Sche );
+
+        Sched_stopTimer( &Sche, timer );
+    }
+
+    TEST_ASSERT_EQUAL( elapsed[0], elapsed[1] );
+    TEST_ASSERT_EQUAL( timerCount[0], timerCount[1] );
+    TEST_ASSERT_EQUAL( runs[0], runs[1] );
+    TEST_ASSERT_NOT_EQUAL( 0, runs[1] );
+    TEST_ASSERT_EQUAL( 6, wakeups[0] );                 // Ticks 0 to 5
+    TEST_ASSERT_LESS_THAN( wakeups[0], wakeups[1] );    // Only the ticks with work
+    TEST_ASSERT_EQUAL( Sche.timeoutUs / Sche.tickUs, Sche.ticksCount );
+}
+
 
-void fun1(void) {}
-void fun2(void) {}
\ No newline at end of file
+/**
+ * @brief Test timer expiry tick
+ * 
+ * This test verifies that a timer fires once its timeout is over, that running the scheduler
+ * again does not process the last tick twice and that the timer can be reloaded
+*/
+void test__timerExpiryTick(void)
+{
+    uint8_t timer;
+
+    count = 0;
+    Sche.timeoutUs = SCHED_MS( 300 );
+
+    Sched_initScheduler( &Sche );
+
+    timer = Sched_registerTimerUs( &Sche, SCHED_MS( 300 ), countFun );
+    Sched_startTimer( &Sche, timer );
+
+    TEST_ASSERT_EQUAL( SCHED_MS( 300 ), Sched_getTimerUs( &Sche, timer ) );
+
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 1, count );
+    TEST_ASSERT_EQUAL( 0, Sched_getTimerUs( &Sche, timer ) );
+
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 1, count );
+
+    Sched_reloadTimerUs( &Sche, timer, SCHED_MS( 200 ) );
+
+    TEST_ASSERT_EQUAL( SCHED_MS( 200 ), Sched_getTimerUs( &Sche, timer ) );
+
+    Sched_stopTimer( &Sche, timer );
+}
+
+
+/**
+ * @brief Test EDF policy
+ * 
+ * This test releases three tasks on the same tick and verifies that FIFO runs them in
+ * registration order, also when the policy is changed after init, while EDF runs them by
+ * earliest deadline
+*/
+void test__edfPolicy(void)
+{
+    Sche.timeoutUs = SCHED_MS( 200 );
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, orderFun1, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, orderFun2, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, orderFun3, SCHED_MS( 200 ) );
+
+    Sche.policy = SCHED_POLICY_PRIORITY;                // Only taken at the next init
+    Sched_priorityTask( &Sche, 3, 0 );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 3, count );
+    TEST_ASSERT_EQUAL( 1, runOrder[0] );
+    TEST_ASSERT_EQUAL( 2, runOrder[1] );
+    TEST_ASSERT_EQUAL( 3, runOrder[2] );
+
+    Sche.policy = SCHED_POLICY_EDF;
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, orderFun1, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, orderFun2, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, orderFun3, SCHED_MS( 200 ) );
+
+    uint8_t res = Sched_deadlineTaskUs( &Sche, 2, SCHED_MS( 100 ) );
+    uint8_t res2 = Sched_deadlineTaskUs( &Sche, 3, 0 );
+    uint8_t res3 = Sched_deadlineTaskUs( &Sche, 1, SCHED_MS( 150 ) );
+    uint8_t res4 = Sched_deadlineTaskUs( &Sche, 4, SCHED_MS( 100 ) );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( TRUE, res2 );
+    TEST_ASSERT_EQUAL( FALSE, res3 );
+    TEST_ASSERT_EQUAL( FALSE, res4 );
+    TEST_ASSERT_EQUAL( 3, count );
+    TEST_ASSERT_EQUAL( 2, runOrder[0] );
+    TEST_ASSERT_EQUAL( 1, runOrder[1] );
+    TEST_ASSERT_EQUAL( 3, runOrder[2] );
+}
+
+
+/**
+ * @brief Test priority policy
+ * 
+ * This test releases three tasks on the same tick and verifies that they run by priority
+*/
+void test__priorityPolicy(void)
+{
+    Sche.timeoutUs = SCHED_MS( 200 );
+    Sche.policy = SCHED_POLICY_PRIORITY;
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, orderFun1, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, orderFun2, SCHED_MS( 200 ) );
+    Sched_registerTaskUs( &Sche, fun1, orderFun3, SCHED_MS( 200 ) );
+
+    uint8_t res = Sched_priorityTask( &Sche, 3, 0 );
+    uint8_t res2 = Sched_priorityTask( &Sche, 1, 10 );
+    uint8_t res3 = Sched_priorityTask( &Sche, 2, 64 );
+    uint8_t res4 = Sched_priorityTask( &Sche, 0, 1 );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( TRUE, res2 );
+    TEST_ASSERT_EQUAL( FALSE, res3 );
+    TEST_ASSERT_EQUAL( FALSE, res4 );
+    TEST_ASSERT_EQUAL( 3, count );
+    TEST_ASSERT_EQUAL( 3, runOrder[0] );
+    TEST_ASSERT_EQUAL( 1, runOrder[1] );
+    TEST_ASSERT_EQUAL( 2, runOrder[2] );
+}
+
+
+/**
+ * @brief Test worker pool
+ * 
+ * This test runs a task slower than its period on a worker pool and verifies that it never
+ * overlaps with itself and that the scheduler waits for it before returning. Pins to a
+ * worker the pool does not have are refused, or dropped at start if the pool came later
+*/
+void test__workerPool(void)
+{
+    static Pool pool;
+
+    TEST_ASSERT_EQUAL( TRUE, Pool_initPool( &pool, 2 ) );
+
+    Sche.timeoutUs = SCHED_MS( 1000 );
+
+    Sched_initScheduler( &Sche );
+
+    uint8_t other = Sched_registerTaskUs( &Sche, fun1, fun1, SCHED_MS( 100 ) );
+    uint8_t res3 = Sched_pinTask( &Sche, other, 5 );    // No pool yet
+    Sche.pool = &pool;
+
+    uint8_t task = Sched_registerTaskUs( &Sche, fun1, slowFun, SCHED_MS( 100 ) );
+    uint8_t res = Sched_pinTask( &Sche, task, 1 );
+    uint8_t res2 = Sched_pinTask( &Sche, task + 1, 1 );
+    uint8_t res4 = Sched_pinTask( &Sche, task, 2 );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( FALSE, res2 );
+    TEST_ASSERT_EQUAL( TRUE, res3 );
+    TEST_ASSERT_EQUAL( FALSE, res4 );
+    TEST_ASSERT_EQUAL( 1, Sche.taskPtr[ task - 1 ].job.worker );
+    TEST_ASSERT_EQUAL( POOL_ANY_WORKER, Sche.taskPtr[ other - 1 ].job.worker );
+    TEST_ASSERT_EQUAL( 0, atomic_load( &Sche.taskPtr[ task - 1 ].job.busy ) );
+    TEST_ASSERT_NOT_EQUAL( 0, count );
+    TEST_ASSERT_LESS_THAN( 5, count );
+
+    Pool_stopPool( &pool );
+}
+
+
+/**
+ * @brief Test task and timer statistics
+ * 
+ * This test attaches statistics to a task and a timer and verifies the recorded values
+*/
+void test__taskStats(void)
+{
+    static Stats_Record taskStats;
+    static Stats_Record timerStats;
+    uint8_t timer;
+
+    Sche.timeoutUs = SCHED_MS( 1000 );
+
+    Sched_initScheduler( &Sche );
+
+    uint8_t task = Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 200 ) );
+    timer = Sched_registerTimerUs( &Sche, SCHED_MS( 500 ), fun1 );
+    Sched_startTimer( &Sche, timer );
+
+    uint8_t res = Sched_statsTask( &Sche, task, &taskStats );
+    uint8_t res2 = Sched_statsTask( &Sche, task + 1, &taskStats );
+    uint8_t res3 = Sched_statsTimer( &Sche, timer, &timerStats );
+    uint8_t res4 = Sched_statsTimer( &Sche, 0, &timerStats );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( FALSE, res2 );
+    TEST_ASSERT_EQUAL( TRUE, res3 );
+    TEST_ASSERT_EQUAL( FALSE, res4 );
+    TEST_ASSERT_EQUAL( count, taskStats.runs );
+    TEST_ASSERT_EQUAL( 0, taskStats.overruns );
+    TEST_ASSERT_LESS_OR_EQUAL( Stats_getAverage( &taskStats ), taskStats.minRun );
+    TEST_ASSERT_GREATER_OR_EQUAL( Stats_getAverage( &taskStats ), taskStats.maxRun );
+    TEST_ASSERT_LESS_OR_EQUAL( taskStats.maxRun, Stats_getRunPercentile( &taskStats, 99 ) );
+    TEST_ASSERT_EQUAL( 6, timerStats.runs );
+
+    Sched_stopTimer( &Sche, timer );
+    Sched_statsTimer( &Sche, timer, NULL );
+}
+
+
+/**
+ * @brief Test catch-up policies
+ * 
+ * This test stalls the scheduler for more than two periods of a task and verifies how many
+ * times every catch-up policy runs it and that the task stays on its slots
+*/
+void test__catchupPolicy(void)
+{
+    const uint8_t policies[ 3 ] = { SCHED_CATCHUP_RESYNC, SCHED_CATCHUP_SKIP, SCHED_CATCHUP_BURST };
+    const uint8_t runs[ 3 ] = { 8, 7, 10 };
+    static Stats_Record stats;
+
+    Sche.timeoutUs = SCHED_MS( 1000 );
+
+    for ( uint8_t i = 0; i < 3; i++ )
+    {
+        Sched_initScheduler( &Sche );
+
+        Sched_registerTaskUs( &Sche, fun1, stallFun, SCHED_MS( 100 ) );
+        uint8_t task = Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 100 ) );
+        uint8_t res = Sched_catchupTask( &Sche, task, policies[ i ] );
+        uint8_t res2 = Sched_catchupTask( &Sche, task, SCHED_CATCHUP_BURST + 1 );
+        Sched_statsTask( &Sche, task, &stats );
+
+        count = 0;
+        stalled = 0;
+        Sched_startScheduler( &Sche );
+
+        TEST_ASSERT_EQUAL( TRUE, res );
+        TEST_ASSERT_EQUAL( FALSE, res2 );
+        TEST_ASSERT_EQUAL( runs[ i ], count );
+        TEST_ASSERT_EQUAL( 10 - runs[ i ], stats.skipped );
+        TEST_ASSERT_EQUAL( SCHED_MS( 1000 ), Sche.taskPtr[ task - 1 ].absLastTime );
+    }
+}
+
+
+/**
+ * @brief Test unregister task and timer functions
+ * 
+ * This test removes tasks and timers, verifies that their handles stop working, that removed
+ * tasks do not run and that the slots are reused with new handles
+*/
+void test__unregister(void)
+{
+    uint32_t handles[ TASKS_N ];
+    uint32_t timer;
+
+    Sche.timeoutUs = SCHED_MS( 200 );
+
+    Sched_initScheduler( &Sche );
+
+    for ( uint8_t i = 0; i < TASKS_N; i++ )
+    {
+        handles[ i ] = Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 100 ) );
+        TEST_ASSERT_EQUAL( i + 1, handles[ i ] );
+    }
+
+    TEST_ASSERT_EQUAL( 0, Sched_registerTaskUs( &Sche, fun1, countFun, 100 ) );      // Full
+
+    for ( uint8_t i = 0; i < TASKS_N; i += 2 )
+    {
+        TEST_ASSERT_EQUAL( TRUE, Sched_unregisterTask( &Sche, handles[ i ] ) );
+    }
+
+    TEST_ASSERT_EQUAL( FALSE, Sched_unregisterTask( &Sche, handles[ 0 ] ) );
+    TEST_ASSERT_EQUAL( FALSE, Sched_stopTask( &Sche, handles[ 0 ] ) );
+    TEST_ASSERT_EQUAL( FALSE, Sched_statsTask( &Sche, handles[ 0 ], NULL ) );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 2 * ( TASKS_N / 2 ), count );          // Only the remaining tasks ran
+
+    uint32_t reused = Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 100 ) );
+
+    TEST_ASSERT_NOT_EQUAL( 0, reused );
+    TEST_ASSERT_NOT_EQUAL( handles[ TASKS_N - 2 ], reused );
+    TEST_ASSERT_EQUAL( fun2, Sche.taskPtr[ TASKS_N - 2 ].taskFunc );       // Last freed slot goes first
+    TEST_ASSERT_EQUAL( TRUE, Sched_stopTask( &Sche, reused ) );
+
+    timer = Sched_registerTimerUs( &Sche, SCHED_MS( 200 ), countFun );
+    Sched_startTimer( &Sche, timer );
+
+    TEST_ASSERT_EQUAL( TRUE, Sched_unregisterTimer( &Sche, timer ) );
+    TEST_ASSERT_EQUAL( FALSE, Sched_unregisterTimer( &Sche, timer ) );
+    TEST_ASSERT_EQUAL( FALSE, Sched_startTimer( &Sche, timer ) );
+    TEST_ASSERT_EQUAL( 0, Sched_getTimerUs( &Sche, timer ) );
+
+    uint32_t timer2 = Sched_registerTimerUs( &Sche, SCHED_MS( 300 ), countFun );
+
+    TEST_ASSERT_NOT_EQUAL( timer, timer2 );
+    TEST_ASSERT_EQUAL( SCHED_MS( 300 ), Sched_getTimerUs( &Sche, timer2 ) );
+    TEST_ASSERT_EQUAL( TRUE, Sched_stopTimer( &Sche, timer2 ) );
+}
+
+
+/**
+ * @brief Writer thread
+ * 
+ * Writes the event queue from another thread while the scheduler sleeps
+*/
+static void *writerThread( void *arg )
+{
+    struct timespec wait = { 0, 250000000 };
+    uint8_t data = 1;
+
+    nanosleep( &wait, NULL );
+    writeTime = Stats_now();
+    Queue_writeData( &eventQueue, &data );
+
+    return arg;
+}
+
+
+/**
+ * @brief Test event tasks
+ * 
+ * This test triggers a task with queue writes from another task and from another thread and
+ * verifies that it runs once per burst of writes, without waiting for the next tick
+*/
+void test__eventTask(void)
+{
+    pthread_t writer;
+
+    eventQueue.Buffer = eventBuffer;
+    eventQueue.Elements = sizeof( eventBuffer );
+    eventQueue.Size = 1;
+    Queue_initQueue( &eventQueue );
+
+    Sche.timeoutUs = SCHED_MS( 500 );
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, producerFun, SCHED_MS( 200 ) );
+    uint32_t task = Sched_registerTaskUs( &Sche, fun1, consumerFun, SCHED_MS( 100 ) );
+    uint8_t res = Sched_triggerTask( &Sche, task, &eventQueue );
+    uint8_t res2 = Sched_triggerTask( &Sche, task + 1, &eventQueue );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( FALSE, res2 );
+    TEST_ASSERT_EQUAL( 2, count );                      // Producer ran on ticks 2 and 4
+    TEST_ASSERT_EQUAL( TRUE, Queue_isQueueEmpty( &eventQueue ) );
+
+    Sched_initScheduler( &Sche );
+
+    Sche.tickless = TRUE;
+    task = Sched_registerTaskUs( &Sche, fun1, consumerFun, SCHED_MS( 100 ) );
+    Sched_triggerTask( &Sche, task, &eventQueue );
+
+    count = 0;
+    readTime = 0;
+    pthread_create( &writer, NULL, writerThread, NULL );
+    Sched_startScheduler( &Sche );
+    pthread_join( writer, NULL );
+
+    TEST_ASSERT_EQUAL( 1, count );
+    TEST_ASSERT_LESS_THAN( TICK_VAL * 1000000ull, readTime - writeTime );     // Less than a tick
+
+    Sched_unregisterTask( &Sche, task );
+
+    TEST_ASSERT_NULL( eventQueue.Notify );
+}
+
+
+/**
+ * @brief Test coroutines
+ * 
+ * This test verifies a coroutine resumes on the tick its sleep, timer or queue wait is over,
+ * and its slot is given back once it finishes
+*/
+void test__coroutine(void)
+{
+    eventQueue.Buffer = eventBuffer;
+    eventQueue.Elements = sizeof( eventBuffer );
+    eventQueue.Size = 1;
+    Queue_initQueue( &eventQueue );
+
+    Sche.timeoutUs = SCHED_MS( 1000 );
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, producerFun, SCHED_MS( 700 ) );
+    coroTimer = Sched_registerTimerUs( &Sche, SCHED_MS( 200 ), fun1 );
+
+    count = 0;
+    uint8_t res = Sched_spawnCoro( &Sche, coroFun, NULL );
+    uint8_t res2 = Sched_spawnCoro( &Sche, coroFun, NULL );
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( FALSE, res2 );                   // Only one coroutine slot
+    TEST_ASSERT_EQUAL( 1, count );
+    TEST_ASSERT_EQUAL( 0, coroFrames[ 0 ].resumed[ 0 ] );
+    TEST_ASSERT_EQUAL( 3, coroFrames[ 0 ].resumed[ 1 ] );      // Slept 300ms
+    TEST_ASSERT_EQUAL( 6, coroFrames[ 0 ].resumed[ 2 ] );      // Timer started on tick 3
+    TEST_ASSERT_EQUAL( 7, coroFrames[ 0 ].resumed[ 3 ] );      // Producer ran on tick 7
+    TEST_ASSERT_EQUAL( 1, coroFrames[ 0 ].data );
+    TEST_ASSERT_NULL( eventQueue.Notify );
+    TEST_ASSERT_EQUAL( TRUE, Sched_spawnCoro( &Sche, coroFun, NULL ) );     // Slot given back
+}
+
+
+/**
+ * @brief Test coroutine listeners
+ * 
+ * This test verifies a coroutine awaiting a stopped timer is resumed at once, and that a
+ * coroutine awaiting the queue of an event task is chained to the task, both run on the
+ * write and the task keeps its trigger once the coroutine finishes
+*/
+void test__coroutineListener(void)
+{
+    eventQueue.Buffer = eventBuffer;
+    eventQueue.Elements = sizeof( eventBuffer );
+    eventQueue.Size = 1;
+    Queue_initQueue( &eventQueue );
+
+    Sche.timeoutUs = SCHED_MS( 700 );
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t producer = Sched_registerTaskUs( &Sche, fun1, producerFun, SCHED_MS( 400 ) );
+    uint32_t consumer = Sched_registerTaskUs( &Sche, fun1, consumerFun, SCHED_MS( 100 ) );
+    uint8_t res = Sched_triggerTask( &Sche, consumer, &eventQueue );
+    uint8_t res2 = Sched_triggerTask( &Sche, producer, &eventQueue );
+    coroTimer = Sched_registerTimerModeUs( &Sche, SCHED_MS( 200 ), SCHED_TIMER_ONESHOT, NULL );
+
+    count = 0;
+    Sched_spawnCoro( &Sche, coroListenFun, NULL );
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( FALSE, res2 );                   // The queue already has a listener
+    TEST_ASSERT_EQUAL( 1, count );                      // Consumer ran on the write of tick 4
+    TEST_ASSERT_EQUAL( 1, coroFrames[ 0 ].resumed[ 1 ] );      // Timer not running
+    TEST_ASSERT_EQUAL( 4, coroFrames[ 0 ].resumed[ 2 ] );
+    TEST_ASSERT_EQUAL( 1, coroFrames[ 0 ].data );
+    TEST_ASSERT_EQUAL_PTR( &tasks[ 1 ], eventQueue.Listener );
+}
+
+
+/**
+ * @brief Test fd sources
+ * 
+ * This test verifies the callback of a registered fd runs on the scheduler thread on the same
+ * tick the fd becomes readable, and that an fd can only be registered once
+*/
+void test__fdSource(void)
+{
+    TEST_ASSERT_EQUAL( 0, pipe( pipeFds ) );
+
+    Sche.timeoutUs = SCHED_MS( 500 );
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, pipeWriteFun, SCHED_MS( 200 ) );
+    uint8_t res = Sched_registerFd( &Sche, pipeFds[ 0 ], SCHED_FD_READ, pipeReadFun );
+    uint8_t res2 = Sched_registerFd( &Sche, pipeFds[ 0 ], SCHED_FD_READ, pipeReadFun );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( TRUE, res );
+    TEST_ASSERT_EQUAL( FALSE, res2 );
+    TEST_ASSERT_EQUAL( 2, count );
+    TEST_ASSERT_EQUAL( 2, readTicks[ 0 ] );             // Read on the ticks the task wrote
+    TEST_ASSERT_EQUAL( 4, readTicks[ 1 ] );
+    TEST_ASSERT_EQUAL( -1, Sche.pollFd );
+    TEST_ASSERT_EQUAL( TRUE, Sched_unregisterFd( &Sche, pipeFds[ 0 ] ) );
+    TEST_ASSERT_EQUAL( FALSE, Sched_unregisterFd( &Sche, pipeFds[ 0 ] ) );
+
+    close( pipeFds[ 0 ] );
+    close( pipeFds[ 1 ] );
+}
+
+
+/**
+ * @brief Test simulated time
+ * 
+ * This test verifies an hour of scheduler time runs in far less than a second of wall time
+ * in simulated mode, and that stepping stops on every tick with a task due
+*/
+void test__simulatedTime(void)
+{
+    static const uint32_t stepTicks[] = { 3, 5, 6, 9, 10 };
+    long start = milliseconds();
+    uint32_t task;
+
+    Sche.simulated = TRUE;
+    Sche.timeoutUs = SCHED_MS( 3600000 );
+
+    Sched_initScheduler( &Sche );
+
+    task = Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 1000 ) );
+
+    count = 0;
+    Sched_runUntilUs( &Sche, SCHED_MS( 2000 ) );
+
+    TEST_ASSERT_EQUAL( 20, Sche.ticksCount );
+    TEST_ASSERT_EQUAL( 2, count );
+
+    Sched_stopTask( &Sche, task );
+    Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 60000 ) );
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 36000, Sche.ticksCount );
+    TEST_ASSERT_EQUAL( 2 + 59, count );                 // One run every minute from 2s on
+    TEST_ASSERT_EQUAL( 3600000ull * 1000000ull, Sche.clock );
+    TEST_ASSERT_LESS_THAN( 1000, milliseconds() - start );
+
+    Sche.timeoutUs = SCHED_MS( 1000 );
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 300 ) );
+    Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 500 ) );
+
+    for ( uint32_t i = 0; i < sizeof( stepTicks ) / sizeof( stepTicks[ 0 ] ); i++ )
+    {
+        TEST_ASSERT_EQUAL( TRUE, Sched_stepScheduler( &Sche ) );
+        TEST_ASSERT_EQUAL( stepTicks[ i ], Sche.ticksCount );
+    }
+
+    TEST_ASSERT_EQUAL( FALSE, Sched_stepScheduler( &Sche ) );
+}
+
+
+/**
+ * @brief Test timer modes
+ * 
+ * This test verifies a one-shot timer fires once, a periodic timer fires every timeout
+ * without being reloaded, and a periodic timer fires once with the expirations the
+ * scheduler jumped over when it falls behind
+*/
+void test__timerModes(void)
+{
+    Sche.timeoutUs = SCHED_MS( 1000 );
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t oneshot = Sched_registerTimerModeUs( &Sche, SCHED_MS( 300 ), SCHED_TIMER_ONESHOT, expiredFun );
+    uint32_t bad = Sched_registerTimerModeUs( &Sche, SCHED_MS( 300 ), SCHED_TIMER_PERIODIC + 1u, expiredFun );
+    Sched_startTimer( &Sche, oneshot );
+
+    count = 0;
+    expirations = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 0, bad );
+    TEST_ASSERT_EQUAL( 1, count );
+    TEST_ASSERT_EQUAL( 1, expirations );
+    TEST_ASSERT_EQUAL( 0, Sched_getTimerUs( &Sche, oneshot ) );
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t periodic = Sched_registerTimerModeUs( &Sche, SCHED_MS( 200 ), SCHED_TIMER_PERIODIC, expiredFun );
+    Sched_startTimer( &Sche, periodic );
+
+    count = 0;
+    expirations = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 5, count );                      // Ticks 2, 4, 6, 8 and 10
+    TEST_ASSERT_EQUAL( 5, expirations );
+
+    Sched_initScheduler( &Sche );
+
+    periodic = Sched_registerTimerModeUs( &Sche, SCHED_MS( 100 ), SCHED_TIMER_PERIODIC, expiredFun );
+    Sched_registerTaskUs( &Sche, fun1, stallFun, SCHED_MS( 300 ) );
+    Sched_startTimer( &Sche, periodic );
+
+    count = 0;
+    expirations = 0;
+    stalled = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_LESS_THAN( 10, count );                 // The stall on tick 3 was jumped over
+    TEST_ASSERT_EQUAL( 10, expirations );               // Ticks 1 to 10
+}
+
+
+/**
+ * @brief Test timer slack
+ * 
+ * This test verifies timers with overlapping slack windows fire together on one tick, and a
+ * periodic timer with slack keeps its period
+*/
+void test__timerSlack(void)
+{
+    static const Sched_Time timeouts[] = { SCHED_MS( 300 ), SCHED_MS( 400 ), SCHED_MS( 500 ), SCHED_MS( 700 ) };
+    static const uint32_t oneshotTicks[] = { 4, 4, 8, 8 };
+    static const uint32_t periodicTicks[] = { 4, 6, 10, 12 };
+
+    Sche.timeoutUs = SCHED_MS( 1300 );
+    Sche.simulated = TRUE;
+
+    Sched_initScheduler( &Sche );
+
+    for ( uint32_t i = 0; i < 4; i++ )
+    {
+        uint32_t timer = Sched_registerTimerModeUs( &Sche, timeouts[ i ], SCHED_TIMER_ONESHOT, slackFun );
+
+        TEST_ASSERT_EQUAL( 1, Sched_slackTimerUs( &Sche, timer, SCHED_MS( 400 ) ) );
+        Sched_startTimer( &Sche, timer );
+    }
+
+    count = 0;
+    expirations = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 4, count );
+    TEST_ASSERT_EQUAL_UINT32_ARRAY( oneshotTicks, firedTicks, 4 );        // Due on ticks 3, 4, 5 and 7
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t periodic = Sched_registerTimerModeUs( &Sche, SCHED_MS( 300 ), SCHED_TIMER_PERIODIC, slackFun );
+
+    TEST_ASSERT_EQUAL( 0, Sched_slackTimerUs( &Sche, periodic, SCHED_MS( 250 ) ) );
+    Sched_startTimer( &Sche, periodic );
+    TEST_ASSERT_EQUAL( 1, Sched_slackTimerUs( &Sche, periodic, SCHED_MS( 200 ) ) );     // Moved while running
+
+    count = 0;
+    expirations = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 4, count );
+    TEST_ASSERT_EQUAL( 4, expirations );
+    TEST_ASSERT_EQUAL_UINT32_ARRAY( periodicTicks, firedTicks, 4 );       // Due on ticks 3, 6, 9 and 12
+}
+
+
+/**
+ * @brief Test trace
+ * 
+ * This test verifies the ticks, tasks, timers and queue accesses are recorded on the trace
+ * ring of the scheduler in order
+*/
+void test__trace(void)
+{
+    static const uint8_t expected[] = { TRACE_TICK_BEGIN, TRACE_TICK_END,          // Tick 1 has no work and is skipped
+                                        TRACE_TICK_BEGIN, TRACE_TASK_BEGIN, TRACE_QUEUE_WRITE, TRACE_QUEUE_WRITE, TRACE_TASK_END,
+                                        TRACE_TIMER_BEGIN, TRACE_TIMER_END, TRACE_TICK_END };
+    Trace_Record record;
+
+    traceRing.buffer = traceRecords;
+    traceRing.size = 64;
+    traceRing.thread = 0;
+    Trace_initRing( &traceRing );
+
+    eventQueue.Buffer = eventBuffer;
+    eventQueue.Elements = sizeof( eventBuffer );
+    eventQueue.Size = 1;
+    Queue_initQueue( &eventQueue );
+
+    Sche.simulated = TRUE;
+    Sche.timeoutUs = SCHED_MS( 200 );
+    Sche.trace = &traceRing;
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, producerFun, SCHED_MS( 200 ) );
+    Sched_startTimer( &Sche, Sched_registerTimerModeUs( &Sche, SCHED_MS( 200 ), SCHED_TIMER_ONESHOT, expiredFun ) );
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_NULL( Trace_currentRing );
+
+    for ( uint32_t i = 0; i < sizeof( expected ); i++ )
+    {
+        TEST_ASSERT_EQUAL( TRUE, Trace_readRing( &traceRing, &record ) );
+        TEST_ASSERT_EQUAL( expected[ i ], record.event );
+    }
+
+    TEST_ASSERT_EQUAL( FALSE, Trace_readRing( &traceRing, &record ) );
+    TEST_ASSERT_EQUAL( 0, traceRing.dropped );
+}
+
+
+/**
+ * @brief Test load
+ * 
+ * This test verifies a task busy for half of every tick shows as half of the load, and the
+ * idle hook runs while the scheduler waits
+*/
+void test__load(void)
+{
+    Sche.timeoutUs = SCHED_MS( 1000 );
+    Sche.idlePtr = idleFun;
+
+    Sched_initScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 0, Sched_loadScheduler( &Sche, 1 ) );
+
+    Sched_registerTaskUs( &Sche, fun1, halfTickFun, SCHED_MS( 100 ) );
+
+    idles = 0;
+    Sched_startScheduler( &Sche );
+
+    uint32_t load = Sched_loadScheduler( &Sche, 10 );
+
+    TEST_ASSERT_UINT32_WITHIN( 150000, 500000, load );
+    TEST_ASSERT_EQUAL( load, Sched_loadScheduler( &Sche, 60 ) );           // Less than 10s of data
+    TEST_ASSERT_GREATER_OR_EQUAL( 10, idles );
+}
+
+
+/**
+ * @brief Test admission
+ * 
+ * This test verifies the registrations and changes that would make the declared task set
+ * miss a deadline are rejected under every policy, and the headroom left is reported
+*/
+void test__admission(void)
+{
+    Sched_initScheduler( &Sche );
+
+    uint32_t taskA = Sched_registerTaskWcetUs( &Sche, fun1, fun2, SCHED_MS( 100 ), 40000 );
+
+    TEST_ASSERT_NOT_EQUAL( 0, taskA );
+    TEST_ASSERT_EQUAL( 600000, Sched_headroomScheduler( &Sche ) );
+    TEST_ASSERT_NOT_EQUAL( 0, Sched_registerTaskWcetUs( &Sche, fun1, fun2, SCHED_MS( 200 ), 40000 ) );
+    TEST_ASSERT_EQUAL( 0, Sched_registerTaskWcetUs( &Sche, fun1, fun2, SCHED_MS( 100 ), 30000 ) );   // 40ms + 30ms wait for task A
+    TEST_ASSERT_EQUAL( 400000, Sched_headroomScheduler( &Sche ) );
+
+    uint32_t taskD = Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 100 ) );
+
+    TEST_ASSERT_NOT_EQUAL( 0, taskD );
+    TEST_ASSERT_EQUAL( 0, Sched_wcetTask( &Sche, taskD, 30000 ) );
+    TEST_ASSERT_EQUAL( 1, Sched_wcetTask( &Sche, taskD, 10000 ) );
+    TEST_ASSERT_EQUAL( 300000, Sched_headroomScheduler( &Sche ) );
+
+    Sche.policy = SCHED_POLICY_EDF;
+    Sched_initScheduler( &Sche );
+
+    uint32_t taskB = Sched_registerTaskWcetUs( &Sche, fun1, fun2, SCHED_MS( 400 ), 100000 );
+
+    taskA = Sched_registerTaskWcetUs( &Sche, fun1, fun2, SCHED_MS( 200 ), 40000 );
+    TEST_ASSERT_EQUAL( 50000, Sched_headroomScheduler( &Sche ) );                      // Task B can block task A
+    TEST_ASSERT_EQUAL( 0, Sched_registerTaskWcetUs( &Sche, fun1, fun2, SCHED_MS( 400 ), 60000 ) );
+    TEST_ASSERT_EQUAL( 1, Sched_deadlineTaskUs( &Sche, taskB, SCHED_MS( 200 ) ) );
+    TEST_ASSERT_EQUAL( 300000, Sched_headroomScheduler( &Sche ) );
+    TEST_ASSERT_EQUAL( 0, Sched_deadlineTaskUs( &Sche, taskA, SCHED_MS( 100 ) ) );
+    TEST_ASSERT_EQUAL( 300000, Sched_headroomScheduler( &Sche ) );
+
+    Sche.policy = SCHED_POLICY_PRIORITY;
+    Sched_initScheduler( &Sche );
+
+    taskA = Sched_registerTaskWcetUs( &Sche, fun1, fun2, SCHED_MS( 100 ), 60000 );
+    taskB = Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 400 ) );
+    TEST_ASSERT_EQUAL( 1, Sched_priorityTask( &Sche, taskA, 0 ) );
+    TEST_ASSERT_EQUAL( 0, Sched_wcetTask( &Sche, taskB, 50000 ) );                    // Blocks task A for too long
+    TEST_ASSERT_EQUAL( 1, Sched_wcetTask( &Sche, taskB, 30000 ) );
+    TEST_ASSERT_EQUAL( 325000, Sched_headroomScheduler( &Sche ) );
+}
+
+
+/**
+ * @brief Test budget
+ * 
+ * This test verifies the watchdog reports a task over its budget while it still runs and
+ * stops it, and without the watchdog every run over budget is reported once it returns
+*/
+void test__budget(void)
+{
+    Stats_Record stats;
+
+    Sche.watchdogUs = SCHED_MS( 5 );
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t task = Sched_registerTaskUs( &Sche, fun1, busyFun, SCHED_MS( 100 ) );
+
+    Sched_statsTask( &Sche, task, &stats );
+    TEST_ASSERT_EQUAL( 0, Sched_budgetTask( &Sche, task, 20000, 2, overrunFun ) );
+    TEST_ASSERT_EQUAL( 1, Sched_budgetTask( &Sche, task, 20000, SCHED_OVERRUN_STOP, overrunFun ) );
+
+    overruns = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 1, stats.runs );             // Stopped after the first run
+    TEST_ASSERT_EQUAL( 1, stats.exceeded );
+    TEST_ASSERT_EQUAL( 1, overruns );
+    TEST_ASSERT_EQUAL( task, overrunHandle );
+    TEST_ASSERT_EQUAL( 1, overrunRunning );         // Found by the watchdog
+
+    Sche.watchdogUs = 0;
+
+    Sched_initScheduler( &Sche );
+
+    task = Sched_registerTaskUs( &Sche, fun1, busyFun, SCHED_MS( 100 ) );
+    Sched_statsTask( &Sche, task, &stats );
+    Sched_budgetTask( &Sche, task, 20000, SCHED_OVERRUN_RECORD, overrunFun );
+
+    overruns = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_GREATER_THAN( 1, stats.runs );
+    TEST_ASSERT_EQUAL( stats.runs, stats.exceeded );
+    TEST_ASSERT_EQUAL( stats.runs, overruns );
+    TEST_ASSERT_EQUAL( 0, overrunRunning );         // Found once every run returned
+}
+
+
+/**
+ * @brief Test budget change
+ * 
+ * This test changes the budget of a task from another worker on every tick while the task
+ * runs and the watchdog checks it, only the runs with a budget are reported
+*/
+void test__budgetChange(void)
+{
+    static Pool pool;
+    Stats_Record stats;
+
+    TEST_ASSERT_EQUAL( TRUE, Pool_initPool( &pool, 2 ) );
+
+    Sche.pool = &pool;
+    Sche.watchdogUs = SCHED_MS( 1 );
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t task = Sched_registerTaskUs( &Sche, fun1, busyFun, SCHED_MS( 100 ) );
+
+    Sched_registerTaskUs( &Sche, fun1, budgetFun, SCHED_MS( 100 ) );
+    Sched_statsTask( &Sche, task, &stats );
+    Sched_budgetTask( &Sche, task, 20000, SCHED_OVERRUN_RECORD, overrunFun );
+
+    budgetHandle = task;
+    budgetRuns = 0;
+    overruns = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 5, stats.runs );
+    TEST_ASSERT_EQUAL( 2, stats.exceeded );         // Ticks 2 and 4, the odd ones have no budget
+    TEST_ASSERT_EQUAL( 2, overruns );
+    TEST_ASSERT_EQUAL( 1, overrunRunning );         // Found by the watchdog
+
+    Pool_stopPool( &pool );
+}
+
+
+/**
+ * @brief Test real-time mode
+ * 
+ * This test verifies the real-time mode runs the tasks whatever it is permitted to do, the
+ * thread gets its scheduling back once the run finishes and the tick jitter is reported
+*/
+void test__realtime(void)
+{
+    struct sched_param param;
+    int policy;
+
+    Sche.realtime = TRUE;
+    Sche.rtPriority = 10;
+    Sche.cpu = 0;
+    Sche.tickless = TRUE;
+
+    Sched_initScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 0, Sched_jitterScheduler( &Sche ) );
+
+    Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 100 ) );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    pthread_getschedparam( pthread_self(), &policy, &param );
+
+    TEST_ASSERT_EQUAL( 5, count );
+    TEST_ASSERT_EQUAL( SCHED_OTHER, policy );
+    TEST_ASSERT_GREATER_THAN( 0, Sched_jitterScheduler( &Sche ) );
+    TEST_ASSERT_LESS_THAN( TICK_VAL * 1000000ull, Sched_jitterScheduler( &Sche ) );
+}
+
+
+
+/**
+ * @brief Test time base
+ * 
+ * This test verifies tasks and timers run on a tick shorter than a millisecond, and that the
+ * tick count goes past 32 bits without the periods or the timers losing their place
+*/
+void test__timeBase(void)
+{
+    Sche.simulated = TRUE;
+    Sche.tickUs = SCHED_US( 250 );
+    Sche.timeoutUs = SCHED_MS( 10 );
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_US( 500 ) );
+    Sched_startTimer( &Sche, Sched_registerTimerModeUs( &Sche, SCHED_US( 750 ), SCHED_TIMER_PERIODIC, expiredFun ) );
+
+    count = 0;
+    expirations = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 40, Sche.ticksCount );
+    TEST_ASSERT_EQUAL( 13, expirations );               // Ticks 3, 6, ... 39
+    TEST_ASSERT_EQUAL( 20 + 13, count );                // The task ran on every even tick
+
+    Sche.tickUs = SCHED_US( 1 );
+    Sche.timeoutUs = SCHED_SEC( 5000 );
+    Sche.tickless = TRUE;
+
+    Sched_initScheduler( &Sche );
+
+    Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_SEC( 1000 ) );
+    Sched_startTimer( &Sche, Sched_registerTimerModeUs( &Sche, SCHED_SEC( 1000 ), SCHED_TIMER_PERIODIC, expiredFun ) );
+    TEST_ASSERT_EQUAL( 0, Sched_registerTimerUs( &Sche, SCHED_SEC( 3000 ), fun1 ) );  // Too many ticks ahead
+
+    count = 0;
+    expirations = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 5000000000ull, Sche.ticksCount );
+    TEST_ASSERT_EQUAL( 5, expirations );
+    TEST_ASSERT_EQUAL( 5 + 5, count );
+}
+
+
+/**
+ * @brief Test ms API
+ * 
+ * This test verifies the functions and the config fields without the Us suffix keep taking
+ * their times in ms, and the Us fields win over the ms ones once they are set
+*/
+void test__msApi(void)
+{
+    Sche.simulated = TRUE;
+    Sche.tick = TICK_VAL;
+    Sche.tickUs = 0;
+    Sche.timeout = 1000;
+    Sche.timeoutUs = 0;
+
+    Sched_initScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( SCHED_MS( TICK_VAL ), Sche.base );
+
+    uint32_t task = Sched_registerTask( &Sche, fun1, countFun, 200 );
+    uint32_t timer = Sched_registerTimerMode( &Sche, 300, SCHED_TIMER_PERIODIC, expiredFun );
+
+    TEST_ASSERT_EQUAL( SCHED_MS( 200 ), Sche.taskPtr[ task - 1 ].period );
+    TEST_ASSERT_EQUAL( SCHED_MS( 300 ), Sche.timerPtr[ timer - 1 ].timeout );
+    TEST_ASSERT_EQUAL( 300, Sched_getTimer( &Sche, timer ) );
+
+    TEST_ASSERT_EQUAL( 1, Sched_periodTask( &Sche, task, 100 ) );
+    TEST_ASSERT_EQUAL( SCHED_MS( 100 ), Sche.taskPtr[ task - 1 ].period );
+
+    Sched_startTimer( &Sche, timer );
+
+    count = 0;
+    expirations = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 1000 / TICK_VAL, Sche.ticksCount );
+    TEST_ASSERT_EQUAL( 3, expirations );                // 300, 600 and 900 ms
+    TEST_ASSERT_EQUAL( 10 + 3, count );                 // The task ran on every tick
+
+    Sche.tickUs = SCHED_US( 500 );
+
+    Sched_initScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( SCHED_US( 500 ), Sche.base );
+}
+
+
+/**
+ * @brief Test static task table
+ * 
+ * This test verifies the tasks of a table built at compile time run on their periods along
+ * with the registered ones, the scheduler wakes up only on the ticks they are due, running
+ * it again does not run them twice and a table built for another tick is refused
+*/
+void test__taskTable(void)
+{
+    Sche.simulated = TRUE;
+    Sche.timeoutUs = SCHED_MS( 1200 );
+
+    Sched_initScheduler( &Sche );
+
+    tableInits = 0;
+    tableRuns[ 0 ] = 0;
+    tableRuns[ 1 ] = 0;
+    count = 0;
+
+    TEST_ASSERT_EQUAL( 1, Sched_tableScheduler( &Sche, &testTable ) );
+    Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 400 ) );
+    Sched_runUntilUs( &Sche, SCHED_MS( 600 ) );
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 2, tableInits );
+    TEST_ASSERT_EQUAL( 6, tableRuns[ 0 ] );
+    TEST_ASSERT_EQUAL( 4, tableRuns[ 1 ] );
+    TEST_ASSERT_EQUAL( 3, count );
+    TEST_ASSERT_EQUAL( 9 + 1, Sched_wakeupsScheduler( &Sche ) );  // Ticks 0, 2, 3, 4, 6, 8, 9, 10 and 12, tick 6 twice
+
+    Sche.tickUs = SCHED_MS( TICK_VAL / 2 );
+
+    Sched_initScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 0, Sched_tableScheduler( &Sche, &testTable ) );
+    TEST_ASSERT_EQUAL( 1, Sched_tableScheduler( &Sche, NULL ) );
+}
+
+
+/**
+ * @brief Test cyclic mode
+ * 
+ * This test verifies the frame table covers the hyperperiod with one frame per gcd of the
+ * periods, the tasks run on their periods with phases that spread them over the frames and
+ * a table that does not fit its buffer leaves every task checked on every tick
+*/
+void test__cyclic(void)
+{
+    static const uint8_t expected[ 13 ] = { 0, 1, 2, 2, 3, 3, 2, 2, 3, 3, 2, 2, 3 };
+    static const uint8_t periods[ 5 ] = { 1, 2, 2, 4, 4 };
+
+    Sche.simulated = TRUE;
+    Sche.timeoutUs = SCHED_MS( 1200 );
+    Sche.cyclic = TRUE;
+    Sche.cyclicPtr = frameBuffer;
+    Sche.cyclicSize = 16;
+
+    Sched_initScheduler( &Sche );
+
+    for ( uint8_t i = 0; i < 5; i++ )
+    {
+        Sched_registerTaskUs( &Sche, fun1, tickFun, SCHED_MS( TICK_VAL ) * periods[ i ] );
+    }
+
+    TEST_ASSERT_EQUAL( 4, Sched_framesScheduler( &Sche ) );
+    TEST_ASSERT_EQUAL( 1, Sche.minorTicks );
+
+    for ( uint8_t i = 0; i < 13; i++ )
+    {
+        tickRuns[ i ] = 0;
+    }
+
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( expected, tickRuns, 13 );     // 12 + 6 + 5 + 3 + 2 runs, 3 at most on a tick
+
+    Sche.cyclicSize = 8;                                // 15 entries needed
+
+    Sched_initScheduler( &Sche );
+
+    for ( uint8_t i = 0; i < 5; i++ )
+    {
+        Sched_registerTaskUs( &Sche, fun1, tickFun, SCHED_MS( TICK_VAL ) * periods[ i ] );
+    }
+
+    TEST_ASSERT_EQUAL( 0, Sched_framesScheduler( &Sche ) );
+
+    for ( uint8_t i = 0; i < 13; i++ )
+    {
+        tickRuns[ i ] = 0;
+    }
+
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 5, tickRuns[ 4 ] );              // Every task on tick 4 without phases
+    TEST_ASSERT_EQUAL( 5, tickRuns[ 12 ] );
+}
+
+
+/**
+ * @brief Test task graph
+ * 
+ * This test verifies tasks depending on other tasks run after them on every activation in
+ * topological order whatever their registration order, the dependencies can not close a
+ * cycle, the latency of every activation is recorded on the last task and the tasks go back
+ * to their period once the task they depend on is unregistered
+*/
+void test__taskGraph(void)
+{
+    static const uint8_t expected[ 8 ] = { 3, 2, 2, 1, 3, 2, 2, 1 };
+    Stats_Record path;
+    uint32_t publish;
+    uint32_t filterB;
+    uint32_t filterA;
+    uint32_t sample;
+
+    Sche.simulated = TRUE;
+    Sche.timeoutUs = SCHED_MS( 800 );
+
+    Sched_initScheduler( &Sche );
+
+    publish = Sched_registerTaskUs( &Sche, fun1, orderFun1, SCHED_MS( TICK_VAL ) );
+    filterB = Sched_registerTaskUs( &Sche, fun1, orderFun2, SCHED_MS( TICK_VAL ) );
+    filterA = Sched_registerTaskUs( &Sche, fun1, orderFun2, SCHED_MS( TICK_VAL ) );
+    sample = Sched_registerTaskUs( &Sche, fun1, orderFun3, SCHED_MS( 400 ) );
+
+    TEST_ASSERT_EQUAL( 1, Sched_dependTask( &Sche, filterA, sample ) );
+    TEST_ASSERT_EQUAL( 1, Sched_dependTask( &Sche, filterB, sample ) );
+    TEST_ASSERT_EQUAL( 1, Sched_dependTask( &Sche, publish, filterA ) );
+    TEST_ASSERT_EQUAL( 1, Sched_dependTask( &Sche, publish, filterB ) );
+    TEST_ASSERT_EQUAL( 0, Sched_dependTask( &Sche, publish, filterB ) );       // Already there
+    TEST_ASSERT_EQUAL( 0, Sched_dependTask( &Sche, sample, publish ) );        // Cycle
+    TEST_ASSERT_EQUAL( 0, Sched_dependTask( &Sche, sample, sample ) );
+    TEST_ASSERT_EQUAL( 0, Sched_triggerTask( &Sche, publish, &eventQueue ) );
+    TEST_ASSERT_EQUAL( 1, Sched_pathTask( &Sche, publish, &path ) );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 8, count );                      // Only on the activations at ticks 4 and 8
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( expected, runOrder, 8 );
+    TEST_ASSERT_EQUAL( 2, path.runs );
+    TEST_ASSERT_EQUAL( 0, path.overruns );              // Every activation ran within its tick
+
+    TEST_ASSERT_EQUAL( 1, Sched_unregisterTask( &Sche, sample ) );
+
+    Sche.timeoutUs = SCHED_MS( 1200 );
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 12, count );                     // Both filters on every tick, publish after them
+    TEST_ASSERT_EQUAL( 4, path.runs - 2 );
+    TEST_ASSERT_EQUAL( 1, runOrder[ 11 ] );
+}
+
+/**
+ * @brief Test dropped activations
+ * 
+ * This test stalls the scheduler so a task bursts through its missed slots ahead of the task
+ * depending on it, and verifies that every activation either runs the dependent task or is
+ * counted as skipped
+*/
+void test__graphSkipped(void)
+{
+    static Stats_Record stats;
+
+    Sche.policy = SCHED_POLICY_PRIORITY;
+    Sche.timeoutUs = SCHED_MS( 1000 );
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t first = Sched_registerTaskUs( &Sche, fun1, countFun, SCHED_MS( 100 ) );
+    uint32_t second = Sched_registerTaskUs( &Sche, fun1, fun2, SCHED_MS( 100 ) );
+    uint32_t stall = Sched_registerTaskUs( &Sche, fun1, stallFun, SCHED_MS( 100 ) );
+
+    Sched_priorityTask( &Sche, first, 0 );
+    Sched_priorityTask( &Sche, second, 1 );
+    Sched_priorityTask( &Sche, stall, 2 );
+    Sched_catchupTask( &Sche, first, SCHED_CATCHUP_BURST );
+    Sched_dependTask( &Sche, second, first );
+    Sched_statsTask( &Sche, second, &stats );
+
+    count = 0;
+    stalled = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 10, count );
+    TEST_ASSERT_NOT_EQUAL( 0, stats.skipped );         // The burst finished again before it ran
+    TEST_ASSERT_EQUAL( count, stats.runs + stats.skipped );
+}
+
+/**
+ * @brief Test dependencies with different periods
+ * 
+ * This test makes a task depend on a fast and a slow task and verifies that it only runs once
+ * both finished, the fast one finishing twice does not count twice, and that a stopped task
+ * does not keep the activation it missed
+*/
+void test__graphPeriods(void)
+{
+    static const uint8_t expected[ 12 ] = { 1, 1, 2, 3, 1, 1, 2, 3, 1, 1, 2, 3 };       // The second fast run does not release it
+    Stats_Record path;
+
+    Sche.simulated = TRUE;
+    Sche.timeoutUs = SCHED_MS( 600 );
+
+    Sched_initScheduler( &Sche );
+
+    uint32_t fast = Sched_registerTaskUs( &Sche, fun1, orderFun1, SCHED_MS( TICK_VAL ) );
+    uint32_t slow = Sched_registerTaskUs( &Sche, fun1, orderFun2, SCHED_MS( 200 ) );
+    uint32_t join = Sched_registerTaskUs( &Sche, fun1, orderFun3, SCHED_MS( 200 ) );
+
+    TEST_ASSERT_EQUAL( 1, Sched_dependTask( &Sche, join, fast ) );
+    TEST_ASSERT_EQUAL( 1, Sched_dependTask( &Sche, join, slow ) );
+    TEST_ASSERT_EQUAL( 1, Sched_pathTask( &Sche, join, &path ) );
+
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 12, count );
+    TEST_ASSERT_EQUAL_UINT8_ARRAY( expected, runOrder, 12 );
+    TEST_ASSERT_EQUAL( 3, path.runs );
+
+    Sched_stopTask( &Sche, join );
+    Sche.timeoutUs = SCHED_MS( 1000 );
+    count = 0;
+    Sched_startScheduler( &Sche );
+    Sched_startTask( &Sche, join );
+    Sche.timeoutUs = SCHED_MS( 1200 );
+    count = 0;
+    Sched_startScheduler( &Sche );
+
+    TEST_ASSERT_EQUAL( 4, path.runs );
+    TEST_ASSERT_LESS_THAN( SCHED_MS( 200 ) * 1000u, path.maxLateness + path.maxRun );     // Not from the stopped activations
+}
+
+void fun1(void) {}
+void fun2(void) {}
+void countFun(void) { count++; }
+void orderFun1(void) { runOrder[ count++ ] = 1; }
+void orderFun2(void) { runOrder[ count++ ] = 2; }
+void orderFun3(void) { runOrder[ count++ ] = 3; }
+void slowFun(void) { long start = milliseconds(); count++; while ( milliseconds() - start < 250 ) {} }
+void stallFun(void) { long start = milliseconds(); while ( ( stalled == 0 ) && ( milliseconds() - start < 350 ) ) {} stalled = 1; }
+void producerFun(void) { uint8_t data = 1; Queue_writeData( &eventQueue, &data ); Queue_writeData( &eventQueue, &data ); }
+void consumerFun(void) { uint8_t data; readTime = Stats_now(); count++; while ( Queue_readData( &eventQueue, &data ) ) {} }
+
+void halfTickFun(void) { long start = milliseconds(); while ( milliseconds() - start < TICK_VAL / 2 ) {} }
+void idleFun(void) { idles++; }
+void slackFun( uint32_t missed ) { expirations += missed; firedTicks[ count++ ] = Sche.ticksCount; }
+void busyFun(void) { atomic_store( &busyRunning, 1 ); halfTickFun(); atomic_store( &busyRunning, 0 ); }
+void overrunFun( uint32_t task ) { overruns++; overrunHandle = task; overrunRunning = atomic_load( &busyRunning ); }
+void tableInit(void) { tableInits++; }
+void tableFun1(void) { tableRuns[ 0 ]++; }
+void tableFun2(void) { tableRuns[ 1 ]++; }
+void tickFun(void) { tickRuns[ Sche.ticksCount ]++; }
+void budgetFun(void) { budgetRuns++; Sched_budgetTask( &Sche, budgetHandle, ( budgetRuns % 2u ) ? 0u : 20000u, SCHED_OVERRUN_RECORD, overrunFun ); }
+void expiredFun( uint32_t missed ) { count++; expirations += missed; }
+void pipeWriteFun(void) { uint8_t data = 1; (void)!write( pipeFds[ 1 ], &data, 1 ); }
+void pipeReadFun( int fd, uint8_t events ) { uint8_t data; if ( ( events & SCHED_FD_READ ) && ( read( fd, &data, 1 ) == 1 ) ) { readTicks[ count++ ] = Sche.ticksCount; } }
+
+void coroListenFun( Sched_Coro *coro )
+{
+    CoroFrame *frame = coro->frame;
+
+    SCHED_CORO_BEGIN( coro );
+    frame->resumed[ 0 ] = Sche.ticksCount;
+    SCHED_CORO_AWAIT_TIMER( coro, coroTimer );
+    frame->resumed[ 1 ] = Sche.ticksCount;
+    SCHED_CORO_WAIT( coro, Sched_awaitQueue( coro, &eventQueue ) );
+    frame->resumed[ 2 ] = Sche.ticksCount;
+    frame->data = 1;
+    SCHED_CORO_END( coro );
+}
+
+void coroFun( Sched_Coro *coro )
+{
+    CoroFrame *frame = coro->frame;
+
+    SCHED_CORO_BEGIN( coro );
+    frame->resumed[ 0 ] = Sche.ticksCount;
+    SCHED_CORO_SLEEP_US( coro, SCHED_MS( 300 ) );
+    frame->resumed[ 1 ] = Sche.ticksCount;
+    Sched_startTimer( &Sche, coroTimer );
+    SCHED_CORO_AWAIT_TIMER( coro, coroTimer );
+    frame->resumed[ 2 ] = Sche.ticksCount;
+    SCHED_CORO_AWAIT_QUEUE( coro, &eventQueue, &frame->data );
+    frame->resumed[ 3 ] = Sche.ticksCount;
+    count++;
+    SCHED_CORO_END( coro );
+}
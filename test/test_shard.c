@@ -0,0 +1,129 @@
+#include <stdatomic.h>
+#include "unity.h"
+#include "shard.h"
+#include "scheduler.h"
+#include "queue.h"
+#include "wheel.h"
+#include "ready.h"
+#include "pool.h"
+#include "stats.h"
+#include "trace.h"
+
+#define TRUE    1
+#define FALSE   0
+
+#define SHARDS_N    2
+#define TASKS_N     4
+#define TICK_VAL    100
+
+static Shard_Runtime runtime;
+static Sched_Scheduler schedulers[ SHARDS_N ];
+static Sched_Scheduler *schedulerPtrs[ SHARDS_N ] = { &schedulers[ 0 ], &schedulers[ 1 ] };
+static Sched_Task tasks[ SHARDS_N ][ TASKS_N ];
+static atomic_uint runs[ SHARDS_N ];
+static atomic_uint misplaced;
+
+
+void fun1(void);
+void shard0Task(void);
+void shard1Task(void);
+
+void setUp(void)
+{
+    for ( uint8_t i = 0; i < SHARDS_N; i++ )
+    {
+        schedulers[ i ].tickUs = SCHED_MS( TICK_VAL );
+        schedulers[ i ].tasks = TASKS_N;
+        schedulers[ i ].taskPtr = tasks[ i ];
+        schedulers[ i ].timeoutUs = SCHED_MS( 500 );
+        schedulers[ i ].tickless = TRUE;
+        atomic_store( &runs[ i ], 0 );
+    }
+
+    atomic_store( &misplaced, 0 );
+}
+
+void tearDown(void)
+{
+    for ( uint8_t i = 0; i < SHARDS_N; i++ )
+    {
+        Sched_deinitScheduler( &schedulers[ i ] );
+    }
+}
+
+
+/**
+ * @brief   Test init runtime function
+ *
+ * The test verifies that the number of shards is checked
+ */
+void test__Shard_initRuntime( void )
+{
+    TEST_ASSERT_EQUAL( FALSE, Shard_initRuntime( &runtime, schedulerPtrs, NULL, 0 ) );
+    TEST_ASSERT_EQUAL( FALSE, Shard_initRuntime( &runtime, schedulerPtrs, NULL, SHARD_MAX + 1 ) );
+    TEST_ASSERT_EQUAL( TRUE, Shard_initRuntime( &runtime, schedulerPtrs, NULL, SHARDS_N ) );
+    TEST_ASSERT_EQUAL( SHARDS_N, runtime.shards );
+    TEST_ASSERT_EQUAL( 1, runtime.shard[ 1 ].cpu );
+    TEST_ASSERT_EQUAL( SHARD_NONE, Shard_currentShard() );
+}
+
+
+/**
+ * @brief   Test register task function
+ *
+ * The test verifies that every task goes to the shard with the lowest utilization
+ */
+void test__Shard_registerTask( void )
+{
+    uint8_t shard[ 4 ];
+
+    Shard_initRuntime( &runtime, schedulerPtrs, NULL, SHARDS_N );
+
+    Shard_registerTaskUs( &runtime, fun1, fun1, SCHED_MS( 100 ), 500, &shard[ 0 ] );
+    Shard_registerTaskUs( &runtime, fun1, fun1, SCHED_MS( 100 ), 500, &shard[ 1 ] );
+    Shard_registerTaskUs( &runtime, fun1, fun1, SCHED_MS( 200 ), 200, &shard[ 2 ] );
+    Shard_registerTaskUs( &runtime, fun1, fun1, SCHED_MS( 100 ), 0, &shard[ 3 ] );
+
+    TEST_ASSERT_EQUAL( 0, shard[ 0 ] );
+    TEST_ASSERT_EQUAL( 1, shard[ 1 ] );
+    TEST_ASSERT_EQUAL( 0, shard[ 2 ] );                 // Tie, lowest shard
+    TEST_ASSERT_EQUAL( 1, shard[ 3 ] );
+    TEST_ASSERT_EQUAL( 6000, runtime.shard[ 0 ].load );
+    TEST_ASSERT_EQUAL( 5001, runtime.shard[ 1 ].load );
+    TEST_ASSERT_EQUAL( 2, schedulers[ 0 ].tasksCount );
+    TEST_ASSERT_EQUAL( 2, schedulers[ 1 ].tasksCount );
+}
+
+
+/**
+ * @brief   Test start and wait runtime functions
+ *
+ * The test verifies that every shard runs its own tasks on its own thread at the same time
+ */
+void test__Shard_startRuntime( void )
+{
+    uint8_t shard[ 2 ];
+    long start;
+
+    Shard_initRuntime( &runtime, schedulerPtrs, NULL, SHARDS_N );
+
+    Shard_registerTaskUs( &runtime, fun1, shard0Task, SCHED_MS( 100 ), 100, &shard[ 0 ] );
+    Shard_registerTaskUs( &runtime, fun1, shard1Task, SCHED_MS( 100 ), 100, &shard[ 1 ] );
+
+    start = milliseconds();
+    TEST_ASSERT_EQUAL( TRUE, Shard_startRuntime( &runtime ) );
+    Shard_waitRuntime( &runtime );
+
+    TEST_ASSERT_EQUAL( 0, shard[ 0 ] );
+    TEST_ASSERT_EQUAL( 1, shard[ 1 ] );
+    TEST_ASSERT_EQUAL( 5, atomic_load( &runs[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 5, atomic_load( &runs[ 1 ] ) );
+    TEST_ASSERT_EQUAL( 0, atomic_load( &misplaced ) );
+    TEST_ASSERT_LESS_THAN( 900, milliseconds() - start );  // Both shards ran at once
+    TEST_ASSERT_EQUAL( 0, runtime.running );
+}
+
+
+void fun1(void) {}
+void shard0Task(void) { atomic_fetch_add( &runs[ 0 ], 1 ); atomic_fetch_add( &misplaced, Shard_currentShard() != 0 ); }
+void shard1Task(void) { atomic_fetch_add( &runs[ 1 ], 1 ); atomic_fetch_add( &misplaced, Shard_currentShard() != 1 ); }
@@ -0,0 +1,125 @@
+#include "unity.h"
+#include "stats.h"
+
+#define TRUE    1
+#define FALSE   0
+
+static Stats_Record stats;
+static Stats_Load load;
+
+
+void setUp(void)
+{
+    Stats_initRecord( &stats );
+}
+
+void tearDown(void)
+{
+}
+
+
+/**
+ * @brief   Test init record function
+ *
+ * The test verifies that a new record has no samples
+ */
+void test__Stats_initRecord( void )
+{
+    TEST_ASSERT_EQUAL( 0, stats.runs );
+    TEST_ASSERT_EQUAL( 0, Stats_getAverage( &stats ) );
+    TEST_ASSERT_EQUAL( 0, Stats_getJitter( &stats ) );
+    TEST_ASSERT_EQUAL( 0, Stats_getRunPercentile( &stats, 50 ) );
+}
+
+
+/**
+ * @brief   Test add run function
+ *
+ * The test records runs and verifies minimum, maximum, average, jitter and overruns
+ */
+void test__Stats_addRun( void )
+{
+    Stats_addRun( &stats, 1000, 1000, 1100, 1000 );
+    Stats_addRun( &stats, 2000, 2050, 2350, 1000 );
+    Stats_addRun( &stats, 3000, 3010, 4510, 1000 );
+    Stats_addSkipped( &stats );
+    Stats_addExceeded( &stats );
+
+    TEST_ASSERT_EQUAL( 3, stats.runs );
+    TEST_ASSERT_EQUAL( 1, stats.overruns );
+    TEST_ASSERT_EQUAL( 1, stats.skipped );
+    TEST_ASSERT_EQUAL( 1, stats.exceeded );
+    TEST_ASSERT_EQUAL( 100, stats.minRun );
+    TEST_ASSERT_EQUAL( 1500, stats.maxRun );
+    TEST_ASSERT_EQUAL( 633, Stats_getAverage( &stats ) );
+    TEST_ASSERT_EQUAL( 0, stats.minLateness );
+    TEST_ASSERT_EQUAL( 50, stats.maxLateness );
+    TEST_ASSERT_EQUAL( 50, Stats_getJitter( &stats ) );
+}
+
+
+/**
+ * @brief   Test percentiles
+ *
+ * The test fills the histogram with known values and verifies that the percentiles fall in
+ * the bucket of the expected value
+ */
+void test__Stats_percentiles( void )
+{
+    for ( uint64_t i = 1; i <= 100; i++ )
+    {
+        Stats_addRun( &stats, 0, 0, i * 1000u, 0 );
+    }
+
+    uint64_t p50 = Stats_getRunPercentile( &stats, 50 );
+    uint64_t p99 = Stats_getRunPercentile( &stats, 99 );
+    uint64_t p100 = Stats_getRunPercentile( &stats, 100 );
+
+    TEST_ASSERT_GREATER_OR_EQUAL( 50000, p50 );
+    TEST_ASSERT_LESS_THAN( 75000, p50 );
+    TEST_ASSERT_GREATER_OR_EQUAL( 99000, p99 );
+    TEST_ASSERT_EQUAL( 100000, p100 );
+    TEST_ASSERT_EQUAL( 0, Stats_getLatenessPercentile( &stats, 99 ) );
+    TEST_ASSERT_EQUAL( 0, stats.overruns );
+}
+
+
+/**
+ * @brief   Test now function
+ *
+ * The test verifies that the monotonic clock never goes back
+ */
+void test__Stats_now( void )
+{
+    uint64_t first = Stats_now();
+    uint64_t second = Stats_now();
+
+    TEST_ASSERT_GREATER_OR_EQUAL( first, second );
+}
+
+
+/**
+ * @brief   Test load functions
+ *
+ * The test accounts busy and idle time over several seconds and verifies the utilization
+ * over the last second and over the whole window, and that old seconds are forgotten
+ */
+void test__Stats_load( void )
+{
+    Stats_initLoad( &load, 0 );
+
+    TEST_ASSERT_EQUAL( 0, Stats_getLoad( &load, 1 ) );
+
+    Stats_addLoad( &load, 250000000ull, 1 );            // Second 0, 25% busy
+    Stats_addLoad( &load, 1000000000ull, 0 );
+    Stats_addLoad( &load, 1750000000ull, 1 );           // Second 1, 75% busy
+    Stats_addLoad( &load, 1999999999ull, 0 );
+
+    TEST_ASSERT_EQUAL( 750000, Stats_getLoad( &load, 1 ) );
+    TEST_ASSERT_EQUAL( 500000, Stats_getLoad( &load, 10 ) );
+    TEST_ASSERT_EQUAL( 500000, Stats_getLoad( &load, 60 ) );
+
+    Stats_addLoad( &load, 120000000000ull, 0 );        // Two minutes idle
+
+    TEST_ASSERT_EQUAL( 0, Stats_getLoad( &load, 60 ) );
+}
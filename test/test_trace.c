@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <string.h>
+#include "unity.h"
+#include "trace.h"
+
+#define TRUE    1
+#define FALSE   0
+
+#define RECORDS_N   4
+
+static Trace_Ring ring;
+static Trace_Record records[ RECORDS_N ];
+
+
+void setUp(void)
+{
+    ring.buffer = records;
+    ring.size = RECORDS_N;
+    ring.thread = 3;
+    Trace_initRing( &ring );
+}
+
+void tearDown(void)
+{
+    Trace_bindRing( NULL );
+}
+
+
+/**
+ * @brief   Test record and read ring functions
+ *
+ * The test verifies that records are read in write order with increasing timestamps and that
+ * a full ring drops the new records
+ */
+void test__Trace_readRing( void )
+{
+    Trace_Record record = { 0 };
+
+    for ( uint32_t i = 0; i < RECORDS_N + 2; i++ )
+    {
+        Trace_record( &ring, TRACE_TASK_BEGIN, i );
+    }
+
+    TEST_ASSERT_EQUAL( 2, ring.dropped );
+
+    for ( uint32_t i = 0; i < RECORDS_N; i++ )
+    {
+        uint64_t last = record.time;
+
+        TEST_ASSERT_EQUAL( TRUE, Trace_readRing( &ring, &record ) );
+        TEST_ASSERT_EQUAL( i, record.id );
+        TEST_ASSERT_EQUAL( TRACE_TASK_BEGIN, record.event );
+        TEST_ASSERT_EQUAL( 3, record.thread );
+
+        if ( i != 0 )
+        {
+            TEST_ASSERT_TRUE( record.time >= last );
+        }
+    }
+
+    TEST_ASSERT_EQUAL( FALSE, Trace_readRing( &ring, &record ) );
+}
+
+
+/**
+ * @brief   Test trace event macro
+ *
+ * The test verifies that events are only recorded on the ring bound to the calling thread
+ */
+void test__Trace_bindRing( void )
+{
+    Trace_Record record;
+
+    TRACE_EVENT( TRACE_TICK_BEGIN, 1 );
+    TEST_ASSERT_EQUAL( FALSE, Trace_readRing( &ring, &record ) );
+
+    Trace_bindRing( &ring );
+    TRACE_EVENT( TRACE_TICK_BEGIN, 2 );
+    Trace_bindRing( NULL );
+    TRACE_EVENT( TRACE_TICK_BEGIN, 3 );
+
+    TEST_ASSERT_EQUAL( TRUE, Trace_readRing( &ring, &record ) );
+    TEST_ASSERT_EQUAL( 2, record.id );
+    TEST_ASSERT_EQUAL( FALSE, Trace_readRing( &ring, &record ) );
+}
+
+
+/**
+ * @brief   Test convert function
+ *
+ * The test writes a trace file and verifies the Chrome trace event JSON it is converted to
+ */
+void test__Trace_convert( void )
+{
+    FILE *trace = tmpfile();
+    FILE *json = tmpfile();
+    char text[ 1024 ] = { 0 };
+
+    Trace_writeHeader( trace );
+    Trace_record( &ring, TRACE_TASK_BEGIN, 7 );
+    Trace_record( &ring, TRACE_TASK_END, 7 );
+    Trace_record( &ring, TRACE_QUEUE_WRITE, 0x1234 );
+    TEST_ASSERT_EQUAL( 3, Trace_writeRing( &ring, trace ) );
+
+    rewind( trace );
+    TEST_ASSERT_EQUAL( TRUE, Trace_convert( trace, json ) );
+
+    rewind( json );
+    TEST_ASSERT_TRUE( fread( text, 1, sizeof( text ) - 1u, json ) > 0 );
+    TEST_ASSERT_NOT_NULL( strstr( text, "{\"traceEvents\":[" ) );
+    TEST_ASSERT_NOT_NULL( strstr( text, "\"name\":\"task 7\",\"cat\":\"task\",\"ph\":\"B\"" ) );
+    TEST_ASSERT_NOT_NULL( strstr( text, "\"name\":\"task 7\",\"cat\":\"task\",\"ph\":\"E\"" ) );
+    TEST_ASSERT_NOT_NULL( strstr( text, "\"queue\":\"0x00001234\"" ) );
+    TEST_ASSERT_NOT_NULL( strstr( text, "\"tid\":3" ) );
+
+    rewind( json );
+    TEST_ASSERT_EQUAL( FALSE, Trace_convert( json, trace ) );     // Not a trace file
+
+    fclose( trace );
+    fclose( json );
+}
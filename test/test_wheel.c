@@ -0,0 +1,154 @@
+#include "unity.h"
+#include "wheel.h"
+
+#define TRUE    1
+#define FALSE   0
+
+#define NODES_N     64
+
+static Wheel wheel;
+static Wheel_Node nodes[ NODES_N ];
+static uint32_t expiries[ NODES_N ];
+static uint32_t fired[ NODES_N ];
+
+
+void setUp(void)
+{
+    Wheel_initWheel( &wheel, 0 );
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        Wheel_initNode( &nodes[ i ] );
+        fired[ i ] = 0;
+    }
+}
+
+void tearDown(void)
+{
+}
+
+
+/**
+ * @brief   Expire nodes helper
+ *
+ * Pops every expired node and stores the tick it expired on
+ */
+static void expireNodes( uint32_t tick )
+{
+    for ( Wheel_Node *node = Wheel_popExpired( &wheel ); node != NULL; node = Wheel_popExpired( &wheel ) )
+    {
+        fired[ node - nodes ] = tick;
+    }
+}
+
+
+/**
+ * @brief   Test insert and expire on every level
+ *
+ * The test inserts nodes whose expiries fall on every level of the wheel and verifies that
+ * every node expires exactly on its tick
+ */
+void test__Wheel_expireAllLevels( void )
+{
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        expiries[ i ] = 1 + ( ( i * i * 2654435761u ) % 300000u );
+        Wheel_insert( &wheel, &nodes[ i ], expiries[ i ] );
+    }
+
+    for ( uint32_t tick = 0; tick <= 300000u; tick++ )
+    {
+        Wheel_advance( &wheel );
+        expireNodes( tick );
+    }
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        TEST_ASSERT_EQUAL( expiries[ i ], fired[ i ] );
+        TEST_ASSERT_EQUAL( FALSE, Wheel_isLinked( &nodes[ i ] ) );
+    }
+}
+
+
+/**
+ * @brief   Test remove function
+ *
+ * The test verifies that a removed node never expires and leaves the wheel empty
+ */
+void test__Wheel_remove( void )
+{
+    Wheel_insert( &wheel, &nodes[ 0 ], 10 );
+    Wheel_insert( &wheel, &nodes[ 1 ], 5000 );
+
+    TEST_ASSERT_EQUAL( TRUE, Wheel_isLinked( &nodes[ 0 ] ) );
+
+    Wheel_remove( &wheel, &nodes[ 0 ] );
+    Wheel_remove( &wheel, &nodes[ 1 ] );
+    Wheel_remove( &wheel, &nodes[ 1 ] );
+
+    TEST_ASSERT_EQUAL( FALSE, Wheel_isLinked( &nodes[ 0 ] ) );
+    TEST_ASSERT_EQUAL( 1000, Wheel_nextEvent( &wheel, 1000 ) );
+
+    for ( uint32_t tick = 0; tick < 6000; tick++ )
+    {
+        Wheel_advance( &wheel );
+        expireNodes( tick );
+    }
+
+    TEST_ASSERT_EQUAL( 0, fired[ 0 ] );
+    TEST_ASSERT_EQUAL( 0, fired[ 1 ] );
+}
+
+
+/**
+ * @brief   Test next event and skip functions
+ *
+ * The test jumps from event to event and verifies that no expiry is lost or delayed
+ */
+void test__Wheel_skipToNextEvent( void )
+{
+    uint32_t tick = 0;
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        expiries[ i ] = 3 + ( ( i * 40503u * i ) % 20000000u );
+        Wheel_insert( &wheel, &nodes[ i ], expiries[ i ] );
+    }
+
+    while ( tick <= 20000000u )
+    {
+        uint32_t skip = Wheel_nextEvent( &wheel, 20000001u - tick );
+
+        Wheel_skip( &wheel, skip );
+        tick += skip;
+
+        Wheel_advance( &wheel );
+        expireNodes( tick );
+        tick++;
+    }
+
+    for ( uint32_t i = 0; i < NODES_N; i++ )
+    {
+        TEST_ASSERT_EQUAL( expiries[ i ], fired[ i ] );
+    }
+}
+
+
+/**
+ * @brief   Test late insert
+ *
+ * The test verifies that a node inserted with an expiry in the past expires on the next tick
+ */
+void test__Wheel_lateInsert( void )
+{
+    Wheel_initWheel( &wheel, 100 );
+
+    Wheel_insert( &wheel, &nodes[ 0 ], 50 );
+
+    TEST_ASSERT_EQUAL( 0, Wheel_nextEvent( &wheel, 10 ) );
+
+    Wheel_advance( &wheel );
+
+    TEST_ASSERT_EQUAL_PTR( &nodes[ 0 ], Wheel_popExpired( &wheel ) );
+    TEST_ASSERT_EQUAL_PTR( NULL, Wheel_popExpired( &wheel ) );
+}